@@ -0,0 +1,64 @@
+/**
+ * \file bench.h
+ *
+ * \brief Timing and reporting helpers shared by libdll benchmarks.
+ *
+ * Every measurement is printed as one JSON object per line, so results can be collected
+ * and compared between runs.
+ */
+
+#ifndef LIBDLL_BENCH_H
+#define LIBDLL_BENCH_H
+
+#ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * \b Current monotonic time in seconds.
+ */
+static inline double bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \b Prints one measurement: \p ops operations of \p impl in \p bench took \p seconds .
+ */
+static inline void
+    bench_report(const char * bench, const char * impl, size_t size, size_t ops, double seconds) {
+  printf("{\"bench\":\"%s\",\"impl\":\"%s\",\"size\":%zu,\"ops\":%zu,\"seconds\":%.9f,"
+         "\"ops_per_sec\":%.1f}\n",
+         bench,
+         impl,
+         size,
+         ops,
+         seconds,
+         seconds > 0 ? (double)ops / seconds : 0.0);
+  fflush(stdout);
+}
+
+/**
+ * \b Fills \p order with a random permutation of [0, \p n ).
+ */
+static inline void bench_shuffle(size_t * order, size_t n, unsigned long long seed) {
+  for (size_t i = 0; n > i; ++i) {
+    order[i] = i;
+  }
+  for (size_t i = n; 1 < i; --i) {
+    seed          = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const size_t j = (size_t)(seed >> 33) % i;
+    const size_t t = order[i - 1];
+
+    order[i - 1] = order[j];
+    order[j]     = t;
+  }
+}
+
+#endif /* LIBDLL_BENCH_H */
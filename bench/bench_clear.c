@@ -0,0 +1,56 @@
+/**
+ * \file bench_clear.c
+ *
+ * \brief Throughput of #dll_clear in list-objects per second against the previous
+ * implementation, which popped and freed list-objects one by one.
+ *
+ * cc -O2 -I.. bench_clear.c -o bench_clear
+ */
+
+#include "bench.h"
+
+#include "../libdll.h"
+
+static void legacy_clear(dll_t * restrict dll) {
+  while (dll->objs_count) {
+    dll_obj_t * restrict obj = dll_pop_front(dll);
+
+    dll_free_obj(&obj);
+  }
+}
+
+static void fill(dll_t * restrict dll, size_t n) {
+  for (size_t i = 0; n > i; ++i) {
+    dll_emplace_back(dll, malloc(sizeof(i)), sizeof(i), LIBDLL_DESTRUCTOR_DEFAULT);
+  }
+}
+
+int main(void) {
+  static const size_t sizes[] = {1000, 100000, 1000000};
+
+  for (size_t s = 0; sizeof(sizes) / sizeof(*sizes) > s; ++s) {
+    const size_t n        = sizes[s];
+    const size_t reps     = 10000000 / n;
+    double       t_legacy = 0;
+    double       t_clear  = 0;
+    dll_t *      dll      = dll_new();
+
+    for (size_t r = 0; reps > r; ++r) {
+      fill(dll, n);
+      double t = bench_now();
+      legacy_clear(dll);
+      t_legacy += bench_now() - t;
+
+      fill(dll, n);
+      t = bench_now();
+      dll_clear(dll);
+      t_clear += bench_now() - t;
+    }
+
+    bench_report("clear", "legacy", n, n * reps, t_legacy);
+    bench_report("clear", "dll_clear", n, n * reps, t_clear);
+    dll_free(&dll);
+  }
+
+  return 0;
+}
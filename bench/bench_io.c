@@ -0,0 +1,105 @@
+/**
+ * \file bench_io.c
+ *
+ * \brief Checkpointing a list to a file: one \c write per payload against
+ * #dll_serialize_fd , and reading it back with #dll_deserialize_fd . Cold start of a
+ * traversal: #dll_deserialize_fd against #dll_map_open_fd of a mapped list file.
+ *
+ * cc -O2 -I.. bench_io.c -o bench_io
+ */
+
+#include "bench.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+
+#include "../libdllio.h"
+
+static ssize_t sum_first_bytes(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  *(size_t *)any += data ? *(unsigned char *)data : 0;
+  return 0;
+}
+
+static void per_object_write(const dll_t * dll, int fd) {
+  for (dll_obj_t * iobj = dll->head; iobj; iobj = iobj->next) {
+    const uint64_t size = iobj->size;
+
+    if (sizeof(size) != write(fd, &size, sizeof(size)) ||
+        (ssize_t)iobj->size != write(fd, iobj->data, iobj->size)) {
+      perror("write");
+      exit(1);
+    }
+  }
+}
+
+int main(void) {
+  static const size_t sizes[] = {1000, 100000, 1000000};
+  char                path[]  = "/tmp/libdll_bench_io_XXXXXX";
+  const int           fd      = mkstemp(path);
+
+  if (0 > fd) {
+    perror("mkstemp");
+    return 1;
+  }
+  unlink(path);
+
+  for (size_t s = 0; sizeof(sizes) / sizeof(*sizes) > s; ++s) {
+    const size_t n   = sizes[s];
+    dll_t *      dll = dll_new();
+
+    for (size_t i = 0; n > i; ++i) {
+      const size_t size = 8 + i % 56;
+
+      dll_emplace_back(dll, calloc(1, size), size, LIBDLL_DESTRUCTOR_DEFAULT);
+    }
+
+    ftruncate(fd, 0);
+    lseek(fd, 0, SEEK_SET);
+    double t = bench_now();
+    per_object_write(dll, fd);
+    bench_report("serialize", "write_per_obj", n, n, bench_now() - t);
+
+    ftruncate(fd, 0);
+    lseek(fd, 0, SEEK_SET);
+    t = bench_now();
+    dll_serialize_fd(dll, fd);
+    bench_report("serialize", "dll_serialize_fd", n, n, bench_now() - t);
+
+    lseek(fd, 0, SEEK_SET);
+    t                   = bench_now();
+    dll_t * restore     = dll_deserialize_fd(fd);
+    const double t_load = bench_now() - t;
+    bench_report("deserialize", "dll_deserialize_fd", n, n, t_load);
+
+    if (NULL == restore || n != restore->objs_count) {
+      fprintf(stderr, "deserialized list of %zu list-objects is broken\n", n);
+      return 1;
+    }
+
+    size_t sum = 0;
+    t          = bench_now();
+    dll_foreach(restore, sum_first_bytes, &sum);
+    bench_report("load_traverse", "dll_deserialize_fd", n, n, bench_now() - t + t_load);
+    dll_free(&restore);
+
+    ftruncate(fd, 0);
+    lseek(fd, 0, SEEK_SET);
+    dll_map_write_fd(dll, fd);
+
+    t               = bench_now();
+    dll_map_t * map = dll_map_open_fd(fd);
+    dll_map_foreach(map, sum_first_bytes, &sum);
+    bench_report("load_traverse", "dll_map_open_fd", n, n, bench_now() - t);
+
+    if (NULL == map || n != dll_map_size(map)) {
+      fprintf(stderr, "mapped list of %zu list-objects is broken\n", n);
+      return 1;
+    }
+    dll_map_close(&map);
+    dll_free(&dll);
+  }
+
+  close(fd);
+  return 0;
+}
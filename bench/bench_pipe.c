@@ -0,0 +1,135 @@
+/**
+ * \file bench_pipe.c
+ *
+ * \brief A filter, map, take and sum chain over a list: #dll_foreach filtering into an
+ * array and mapping it into another one, against a #dll_pipe pipeline fusing the stages
+ * into one traversal. Taking a few values shows the early termination of the pipeline.
+ *
+ * cc -O2 -I.. bench_pipe.c -o bench_pipe
+ */
+
+#include "bench.h"
+
+#include <stdint.h>
+
+#include "../libdllpipe.h"
+
+typedef struct {
+  size_t key;
+  size_t value;
+} record_t;
+
+static void * project_value(void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return &((record_t *)data)->value;
+}
+
+static ssize_t even_key(void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return (ssize_t)(((record_t *)data)->key & 1);
+}
+
+static void *
+    sum_value(void * acc, void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return (void *)((uintptr_t)acc + *(size_t *)data);
+}
+
+typedef struct {
+  record_t ** records;
+  size_t      count;
+} kept_t;
+
+static ssize_t keep_even_key(void * restrict data, void * restrict any, size_t index) {
+  kept_t * kept = any;
+
+  (void)index;
+  if (0 == even_key(data, NULL, 0)) {
+    kept->records[kept->count++] = data;
+  }
+  return 0;
+}
+
+/**
+ * \b Sums values of the first \p take records with even keys, materializing every stage.
+ */
+static size_t staged_sum(const dll_t * dll, size_t take) {
+  kept_t   kept   = {malloc(dll->objs_count * sizeof(record_t *)), 0};
+  size_t * values = NULL;
+  size_t   sum    = 0;
+
+  dll_foreach(dll, keep_even_key, &kept);
+  values = malloc((kept.count + 1) * sizeof(*values));
+  for (size_t i = 0; kept.count > i; ++i) {
+    values[i] = *(size_t *)project_value(kept.records[i], NULL, i);
+  }
+  for (size_t i = 0; kept.count > i && take > i; ++i) {
+    sum += values[i];
+  }
+
+  free(values);
+  free(kept.records);
+  return sum;
+}
+
+/**
+ * \b Sums values of the first \p take records with even keys in one pipeline.
+ */
+static size_t pipe_sum(dll_t * dll, size_t take) {
+  dll_iterator_t it   = dll_iterator(dll);
+  dll_pipe_t     pipe = dll_pipe(&it);
+
+  dll_pipe_filter(&pipe, even_key, NULL);
+  dll_pipe_take(&pipe, take);
+  dll_pipe_map(&pipe, project_value, NULL);
+  return (size_t)(uintptr_t)dll_pipe_reduce(&pipe, sum_value, NULL, NULL);
+}
+
+int main(void) {
+  static const size_t sizes[] = {1000, 100000, 1000000};
+  static const size_t takes[] = {10, ~(size_t)0};
+
+  for (size_t s = 0; sizeof(sizes) / sizeof(*sizes) > s; ++s) {
+    const size_t n    = sizes[s];
+    const size_t reps = 1 + 10000000 / n;
+    dll_t *      dll  = dll_new();
+
+    for (size_t i = 0; n > i; ++i) {
+      record_t * record = malloc(sizeof(*record));
+
+      record->key   = i * 7;
+      record->value = i;
+      dll_emplace_back(dll, record, sizeof(*record), LIBDLL_DESTRUCTOR_DEFAULT);
+    }
+
+    for (size_t k = 0; sizeof(takes) / sizeof(*takes) > k; ++k) {
+      const char * bench  = 10 == takes[k] ? "filter_map_take10" : "filter_map_sum";
+      size_t       staged = 0;
+      size_t       piped  = 0;
+
+      double t = bench_now();
+      for (size_t r = 0; reps > r; ++r) {
+        staged += staged_sum(dll, takes[k]);
+      }
+      bench_report(bench, "staged_arrays", n, n * reps, bench_now() - t);
+
+      t = bench_now();
+      for (size_t r = 0; reps > r; ++r) {
+        piped += pipe_sum(dll, takes[k]);
+      }
+      bench_report(bench, "dll_pipe", n, n * reps, bench_now() - t);
+
+      if (staged != piped) {
+        fprintf(stderr, "%s of %zu list-objects: %zu != %zu\n", bench, n, staged, piped);
+        return 1;
+      }
+    }
+
+    dll_free(&dll);
+  }
+
+  return 0;
+}
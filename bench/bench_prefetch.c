@@ -0,0 +1,98 @@
+/**
+ * \file bench_prefetch.c
+ *
+ * \brief Traversal throughput of #dll_foreach , #dll_find and #dll_is_equal over lists
+ * whose list-objects and data are linked in an order unrelated to their addresses.
+ *
+ * Build it twice to compare prefetching against none:
+ * cc -O2 -I.. -DLIBDLL_PREFETCH_DISTANCE=2 bench_prefetch.c -o bench_prefetch
+ * cc -O2 -I.. bench_prefetch.c -o bench_prefetch_off
+ */
+
+#include "bench.h"
+
+#include "../libdll.h"
+
+#define BENCH_STR(_x)  #_x
+#define BENCH_XSTR(_x) BENCH_STR(_x)
+#define BENCH_IMPL     "prefetch_" BENCH_XSTR(LIBDLL_PREFETCH_DISTANCE)
+
+static ssize_t sum_data(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  *(size_t *)any += *(size_t *)data;
+  return 0;
+}
+
+static ssize_t find_data(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  return *(size_t *)data == *(size_t *)any ? 0 : 1;
+}
+
+static ssize_t cmp_data(void * restrict a, void * restrict b, void * any, size_t index) {
+  (void)any;
+  (void)index;
+  return (ssize_t)(*(size_t *)a - *(size_t *)b);
+}
+
+/**
+ * \b Allocates \p n list-objects with data in address order, then links them into a new
+ * list in a shuffled order.
+ */
+static dll_t * shuffled_list(size_t n, unsigned long long seed) {
+  dll_t *      dll   = dll_new();
+  dll_obj_t ** objs  = malloc(n * sizeof(*objs));
+  size_t *     order = malloc(n * sizeof(*order));
+
+  for (size_t i = 0; n > i; ++i) {
+    size_t * data = malloc(sizeof(*data));
+
+    *data   = i;
+    objs[i] = dll_new_obj(data, sizeof(*data), LIBDLL_DESTRUCTOR_DEFAULT);
+  }
+
+  bench_shuffle(order, n, seed);
+  for (size_t i = 0; n > i; ++i) {
+    dll_push_back(dll, objs[order[i]]);
+  }
+
+  free(order);
+  free(objs);
+  return dll;
+}
+
+int main(void) {
+  static const size_t sizes[] = {1000, 100000, 1000000, 4000000};
+
+  for (size_t s = 0; sizeof(sizes) / sizeof(*sizes) > s; ++s) {
+    const size_t n    = sizes[s];
+    const size_t reps = 1 + 20000000 / n;
+    dll_t *      a    = shuffled_list(n, 1);
+    dll_t *      b    = shuffled_list(n, 1);
+    size_t       sum  = 0;
+    size_t       key  = ~0UL;
+
+    double t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      dll_foreach(a, sum_data, &sum);
+    }
+    bench_report("foreach_shuffled", BENCH_IMPL, n, n * reps, bench_now() - t);
+
+    t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += NULL != dll_find(a, find_data, &key);
+    }
+    bench_report("find_shuffled", BENCH_IMPL, n, n * reps, bench_now() - t);
+
+    t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += dll_is_equal(a, b, cmp_data, NULL);
+    }
+    bench_report("is_equal_shuffled", BENCH_IMPL, n, n * reps, bench_now() - t);
+
+    fprintf(stderr, "checksum %zu\n", sum);
+    dll_free(&a);
+    dll_free(&b);
+  }
+
+  return 0;
+}
@@ -0,0 +1,570 @@
+/**
+ * \file bench_suite.cpp
+ *
+ * \brief Core list operations of libdll against \c std::list and a Linux-kernel-style
+ * intrusive list: push/pop churn, insertion and erasing by position, sorting of random,
+ * sorted and reversed input, scans, removing duplicates, appending and splicing lists,
+ * and clearing.
+ *
+ * Every implementation runs in its own process, so each starts with a fresh heap. Lists
+ * are built on a heap reused between measurements, so list-objects of later lists are
+ * scattered in memory as in a long-running program, the same way for every
+ * implementation.
+ *
+ * Build it twice to compare the checked and unchecked API; the baselines are reported
+ * by the checked build only:
+ *
+ * c++ -O2 -I.. bench_suite.cpp -o bench_suite
+ * c++ -O2 -DLIBDLL_UNSAFE_USAGE -I.. bench_suite.cpp -o bench_suite_unsafe
+ * ./bench_suite [max list size]
+ */
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../libdll.h"
+
+#ifdef LIBDLL_UNSAFE_USAGE
+#  define LIBDLL_IMPL "libdll_unsafe"
+#else
+#  define LIBDLL_IMPL "libdll"
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+namespace {
+
+//
+// Linux-kernel-style intrusive list
+//
+
+struct list_head {
+  list_head * next;
+  list_head * prev;
+};
+
+struct knode {
+  list_head link;
+  size_t    value;
+};
+
+#define knode_of(_ptr) ((knode *)((char *)(_ptr) - offsetof(knode, link)))
+
+inline void list_init(list_head * head) { head->next = head->prev = head; }
+
+inline void list_link(list_head * node, list_head * prev, list_head * next) {
+  next->prev = node;
+  node->next = next;
+  node->prev = prev;
+  prev->next = node;
+}
+
+inline void list_del(list_head * node) {
+  node->next->prev = node->prev;
+  node->prev->next = node->next;
+}
+
+inline void list_splice_after(list_head * list, list_head * at) {
+  if (list->next == list) {
+    return;
+  }
+
+  list_head * first = list->next;
+  list_head * last  = list->prev;
+
+  first->prev    = at;
+  last->next     = at->next;
+  at->next->prev = last;
+  at->next       = first;
+  list_init(list);
+}
+
+/**
+ * \b Sorts \p head with the same bottom-up merge sort on \c next links that libdll uses,
+ * then restores \c prev links, as the kernel's \c list_sort does.
+ */
+void list_sort(list_head * head) {
+  if (head->next == head->prev) {
+    return;
+  }
+
+  list_head * list = head->next;
+
+  head->prev->next = nullptr;
+  for (size_t width = 1;; width *= 2) {
+    list_head * p      = list;
+    list_head * tail   = nullptr;
+    size_t      merges = 0;
+
+    list = nullptr;
+    while (p) {
+      list_head * q     = p;
+      size_t      psize = 0;
+      size_t      qsize = width;
+
+      for (++merges; width > psize && q; ++psize) {
+        q = q->next;
+      }
+      while (psize || (qsize && q)) {
+        list_head * e = nullptr;
+
+        if (0 == psize) {
+          e = q, q = q->next, --qsize;
+        } else if (0 == qsize || nullptr == q ||
+                   knode_of(p)->value <= knode_of(q)->value) {
+          e = p, p = p->next, --psize;
+        } else {
+          e = q, q = q->next, --qsize;
+        }
+        *(tail ? &tail->next : &list) = e;
+        tail                          = e;
+      }
+      p = q;
+    }
+    tail->next = nullptr;
+    if (1 >= merges) {
+      break;
+    }
+  }
+
+  list_head * prev = head;
+  for (list_head * iobj = list; iobj; prev = iobj, iobj = iobj->next) {
+    iobj->prev = prev;
+    prev->next = iobj;
+  }
+  prev->next = head;
+  head->prev = prev;
+}
+
+//
+// Implementations under test, wrapped into the same interface
+//
+
+struct libdll_impl {
+  static constexpr const char * name = LIBDLL_IMPL;
+
+  dll_t * dll = dll_new();
+
+  ~libdll_impl() { dll_free(&dll); }
+
+  static ssize_t cmp(void * a, void * b, void * any, size_t index) {
+    (void)any;
+    (void)index;
+    return (*(size_t *)a > *(size_t *)b) - (*(size_t *)a < *(size_t *)b);
+  }
+
+  static ssize_t is_key(void * data, void * key, size_t index) {
+    (void)index;
+    return *(size_t *)data == *(size_t *)key ? 0 : 1;
+  }
+
+  static ssize_t add(void * data, void * sum, size_t index) {
+    (void)index;
+    *(size_t *)sum += *(size_t *)data;
+    return 0;
+  }
+
+  void push_back(size_t * value) {
+    dll_emplace_back(dll, value, sizeof(*value), LIBDLL_DESTRUCTOR_NULL);
+  }
+
+  void pop_front() {
+    dll_obj_t * obj = dll_pop_front(dll);
+
+    dll_free_obj(&obj);
+  }
+
+  void insert(size_t pos, size_t * value) {
+    dll_emplace(dll, value, sizeof(*value), LIBDLL_DESTRUCTOR_NULL, pos);
+  }
+
+  void erase(size_t pos) { dll_erase(dll, pos, 0); }
+
+  void sort() { dll_sort(dll, cmp, nullptr); }
+
+  bool find(size_t key) { return dll_find(dll, is_key, &key); }
+
+  size_t sum() {
+    size_t out = 0;
+
+    dll_foreach(dll, add, &out);
+    return out;
+  }
+
+  void unique() { dll_unique(dll, cmp, nullptr); }
+
+  void append(libdll_impl & other) { dll_merge(dll, other.dll, nullptr, nullptr); }
+
+  void splice_middle(libdll_impl & other) {
+    dll_splice(dll, other.dll, size() / 2, 0, 0);
+  }
+
+  void clear() { dll_clear(dll); }
+
+  size_t size() { return dll_size(dll); }
+};
+
+struct std_list_impl {
+  static constexpr const char * name = "std_list";
+
+  std::list<size_t> list;
+
+  void push_back(size_t * value) { list.push_back(*value); }
+
+  void pop_front() { list.pop_front(); }
+
+  void insert(size_t pos, size_t * value) {
+    list.insert(std::next(list.begin(), (long)pos), *value);
+  }
+
+  void erase(size_t pos) { list.erase(std::next(list.begin(), (long)pos)); }
+
+  void sort() { list.sort(); }
+
+  bool find(size_t key) {
+    for (size_t value : list) {
+      if (value == key) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t sum() {
+    size_t out = 0;
+
+    for (size_t value : list) {
+      out += value;
+    }
+    return out;
+  }
+
+  void unique() { list.unique(); }
+
+  void append(std_list_impl & other) { list.splice(list.end(), other.list); }
+
+  void splice_middle(std_list_impl & other) {
+    list.splice(std::next(list.begin(), (long)list.size() / 2 + 1), other.list);
+  }
+
+  void clear() { list.clear(); }
+
+  size_t size() { return list.size(); }
+};
+
+struct intrusive_impl {
+  static constexpr const char * name = "intrusive";
+
+  list_head head;
+  size_t    count = 0;
+
+  intrusive_impl() { list_init(&head); }
+
+  ~intrusive_impl() { clear(); }
+
+  list_head * at(size_t pos) {
+    list_head * iobj = head.next;
+
+    while (pos--) {
+      iobj = iobj->next;
+    }
+    return iobj;
+  }
+
+  void push_back(size_t * value) {
+    knode * node = (knode *)malloc(sizeof(*node));
+
+    node->value = *value;
+    list_link(&node->link, head.prev, &head);
+    ++count;
+  }
+
+  void pop_front() {
+    list_head * first = head.next;
+
+    list_del(first);
+    free(knode_of(first));
+    --count;
+  }
+
+  void insert(size_t pos, size_t * value) {
+    knode *     node = (knode *)malloc(sizeof(*node));
+    list_head * next = at(pos);
+
+    node->value = *value;
+    list_link(&node->link, next->prev, next);
+    ++count;
+  }
+
+  void erase(size_t pos) {
+    list_head * node = at(pos);
+
+    list_del(node);
+    free(knode_of(node));
+    --count;
+  }
+
+  void sort() { list_sort(&head); }
+
+  bool find(size_t key) {
+    for (list_head * iobj = head.next; &head != iobj; iobj = iobj->next) {
+      if (knode_of(iobj)->value == key) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t sum() {
+    size_t out = 0;
+
+    for (list_head * iobj = head.next; &head != iobj; iobj = iobj->next) {
+      out += knode_of(iobj)->value;
+    }
+    return out;
+  }
+
+  void unique() {
+    for (list_head * iobj = head.next; &head != iobj && &head != iobj->next;) {
+      list_head * next = iobj->next;
+
+      if (knode_of(iobj)->value == knode_of(next)->value) {
+        list_del(next);
+        free(knode_of(next));
+        --count;
+      } else {
+        iobj = next;
+      }
+    }
+  }
+
+  void append(intrusive_impl & other) {
+    list_splice_after(&other.head, head.prev);
+    count += other.count;
+    other.count = 0;
+  }
+
+  void splice_middle(intrusive_impl & other) {
+    list_splice_after(&other.head, at(count / 2));
+    count += other.count;
+    other.count = 0;
+  }
+
+  void clear() {
+    for (list_head * iobj = head.next; &head != iobj;) {
+      list_head * next = iobj->next;
+
+      free(knode_of(iobj));
+      iobj = next;
+    }
+    list_init(&head);
+    count = 0;
+  }
+
+  size_t size() { return count; }
+};
+
+//
+// Benchmarks
+//
+
+std::vector<size_t> values;
+
+void fill(size_t n, const char * order, unsigned long long seed) {
+  values.resize(n);
+  if (0 == strcmp("random", order)) {
+    bench_shuffle(values.data(), n, seed);
+    return;
+  }
+  for (size_t i = 0; n > i; ++i) {
+    values[i] = 0 == strcmp("reverse", order) ? n - 1 - i : i;
+  }
+}
+
+template <class Impl> void build(Impl & impl, size_t n) {
+  for (size_t i = 0; n > i; ++i) {
+    impl.push_back(&values[i]);
+  }
+}
+
+void check(bool ok, const char * bench, const char * impl, size_t n) {
+  if (!ok) {
+    fprintf(stderr, "%s of %s at size %zu gave a wrong result\n", bench, impl, n);
+    exit(1);
+  }
+}
+
+template <class Impl> void bench_churn(size_t n) {
+  const size_t ops = n > 1000000 ? n : 1000000;
+  Impl         impl;
+
+  fill(n, "random", 1);
+  build(impl, n);
+
+  const double t = bench_now();
+  for (size_t i = 0; ops > i; ++i) {
+    impl.pop_front();
+    impl.push_back(&values[i % n]);
+  }
+  bench_report("push_pop_churn", Impl::name, n, 2 * ops, bench_now() - t);
+  check(n == impl.size(), "push_pop_churn", Impl::name, n);
+}
+
+template <class Impl> void bench_insert_erase(size_t n) {
+  const size_t       ops  = 1 + 20000000 / n;
+  unsigned long long seed = 7;
+  Impl               impl;
+
+  fill(n, "random", 2);
+  build(impl, n);
+
+  const double t = bench_now();
+  for (size_t i = 0; ops > i; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    const size_t pos = 1 + (size_t)(seed >> 33) % (n - 1);
+
+    impl.insert(pos, &values[i % n]);
+    impl.erase(pos);
+  }
+  bench_report("insert_erase_pos", Impl::name, n, 2 * ops, bench_now() - t);
+  check(n == impl.size(), "insert_erase_pos", Impl::name, n);
+}
+
+template <class Impl> void bench_sort(size_t n, const char * order) {
+  static char bench[32];
+  Impl        impl;
+
+  snprintf(bench, sizeof(bench), "sort_%s", order);
+  fill(n, order, 3);
+  build(impl, n);
+
+  const double t = bench_now();
+  impl.sort();
+  bench_report(bench, Impl::name, n, n, bench_now() - t);
+  check(n == impl.size(), bench, Impl::name, n);
+}
+
+template <class Impl> void bench_scans(size_t n) {
+  const size_t reps = 1 + 10000000 / n;
+  size_t       sum  = 0;
+  bool         hit  = false;
+  Impl         impl;
+
+  fill(n, "random", 4);
+  build(impl, n);
+
+  double t = bench_now();
+  for (size_t r = 0; reps > r; ++r) {
+    hit |= impl.find(n);
+  }
+  bench_report("find_miss", Impl::name, n, n * reps, bench_now() - t);
+
+  t = bench_now();
+  for (size_t r = 0; reps > r; ++r) {
+    sum += impl.sum();
+  }
+  bench_report("foreach_sum", Impl::name, n, n * reps, bench_now() - t);
+  check(!hit && sum == reps * (n * (n - 1) / 2), "scans", Impl::name, n);
+}
+
+template <class Impl> void bench_unique(size_t n) {
+  Impl impl;
+
+  fill(n, "sorted", 5);
+  for (size_t i = 0; n > i; ++i) {
+    values[i] /= 2;
+  }
+  build(impl, n);
+
+  const double t = bench_now();
+  impl.unique();
+  bench_report("unique", Impl::name, n, n, bench_now() - t);
+  check((n + 1) / 2 == impl.size(), "unique", Impl::name, n);
+}
+
+template <class Impl> void bench_append_splice(size_t n) {
+  Impl dst;
+  Impl src;
+
+  fill(n, "random", 6);
+  build(dst, n);
+  build(src, n);
+
+  double t = bench_now();
+  dst.append(src);
+  bench_report("append", Impl::name, n, n, bench_now() - t);
+  check(2 * n == dst.size() && 0 == src.size(), "append", Impl::name, n);
+
+  build(src, n);
+  t = bench_now();
+  dst.splice_middle(src);
+  bench_report("splice_middle", Impl::name, n, n, bench_now() - t);
+  check(3 * n == dst.size() && 0 == src.size(), "splice_middle", Impl::name, n);
+}
+
+template <class Impl> void bench_clear(size_t n) {
+  Impl impl;
+
+  fill(n, "random", 7);
+  build(impl, n);
+
+  const double t = bench_now();
+  impl.clear();
+  bench_report("clear", Impl::name, n, n, bench_now() - t);
+  check(0 == impl.size(), "clear", Impl::name, n);
+}
+
+/**
+ * \b Runs all the benchmarks of \p Impl in a child process.
+ *
+ * \return \c true if all of them gave right results.
+ */
+template <class Impl> bool run(size_t max_size) {
+  static const char * const orders[] = {"random", "sorted", "reverse"};
+  int                       status   = 0;
+  const pid_t               pid      = fork();
+
+  if (0 != pid) {
+    return 0 < pid && pid == waitpid(pid, &status, 0) && WIFEXITED(status) &&
+           0 == WEXITSTATUS(status);
+  }
+
+  for (size_t n = 1000; 1000000 >= n && max_size >= n; n *= 10) {
+    bench_churn<Impl>(n);
+    bench_scans<Impl>(n);
+    bench_append_splice<Impl>(n);
+    bench_clear<Impl>(n);
+  }
+  for (size_t n = 1000; 100000 >= n && max_size >= n; n *= 10) {
+    bench_insert_erase<Impl>(n);
+  }
+  for (size_t n = 1000; 10000 >= n && max_size >= n; n *= 10) {
+    bench_unique<Impl>(n);
+  }
+  for (size_t n = 1000; max_size >= n; n *= 10) {
+    for (const char * order : orders) {
+      bench_sort<Impl>(n, order);
+    }
+  }
+  exit(0);
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+  const size_t max_size = 1 < argc ? strtoul(argv[1], nullptr, 10) : 10000000;
+
+  bool ok = run<libdll_impl>(max_size);
+#ifndef LIBDLL_UNSAFE_USAGE
+  ok = run<std_list_impl>(max_size) && ok;
+  ok = run<intrusive_impl>(max_size) && ok;
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return ok ? 0 : 1;
+}
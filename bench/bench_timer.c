@@ -0,0 +1,130 @@
+/**
+ * \file bench_timer.c
+ *
+ * \brief Millions of timers in a #dll_timer_wheel_t driven by a simulated clock:
+ * throughput of scheduling, cancelling, rescheduling and expiry. Every expired timer is
+ * checked to be handed over on the advance that reached its tick, so the run fails
+ * loudly if the wheel fires a timer early, late or never.
+ *
+ * cc -O2 -I.. bench_timer.c -o bench_timer
+ */
+
+#include "bench.h"
+
+#include <stdlib.h>
+
+#include "../libdlltimer.h"
+
+static unsigned long long rng_state = 42;
+
+static uint64_t rng(void) {
+  rng_state = rng_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return rng_state >> 17;
+}
+
+/**
+ * \b Random delay: mostly short timeouts, some long ones and a few beyond the top level
+ * of the wheel.
+ */
+static uint64_t random_delay(void) {
+  const uint64_t kind = rng() % 100;
+
+  if (90 > kind) {
+    return 1 + rng() % (1 << 12);
+  }
+  if (99 > kind) {
+    return 1 + rng() % (1 << 24);
+  }
+  return 1 + rng() % (UINT64_C(1) << 38);
+}
+
+int main(int argc, char ** argv) {
+  const size_t         n       = 1 < argc ? strtoul(argv[1], NULL, 10) : 2000000;
+  dll_timer_t ** const timers  = malloc(n * sizeof(*timers));
+  dll_timer_wheel_t *  wheel   = dll_timer_wheel_new(0);
+  dll_t *              expired = dll_new();
+  dll_t *              done    = dll_new();
+  size_t               fired   = 0;
+  size_t               resched = 0;
+  size_t               cancels = 0;
+  size_t               steps   = 0;
+  double               t_fire  = 0;
+
+  for (size_t i = 0; n > i; ++i) {
+    timers[i] = dll_timer_new_obj(NULL, 0, LIBDLL_DESTRUCTOR_NULL);
+  }
+
+  double t = bench_now();
+  for (size_t i = 0; n > i; ++i) {
+    dll_timer_schedule(wheel, timers[i], random_delay());
+  }
+  bench_report("timer_schedule", "wheel", n, n, bench_now() - t);
+
+  t = bench_now();
+  for (size_t i = 0; n > i; i += 2) {
+    dll_timer_schedule(wheel, timers[i], wheel->now + random_delay());
+  }
+  bench_report("timer_reschedule", "wheel", n, (n + 1) / 2, bench_now() - t);
+
+  t = bench_now();
+  for (size_t i = 0; n > i; i += 16) {
+    if (dll_timer_cancel(wheel, timers[i])) {
+      dll_push_back(done, &timers[i]->obj);
+      ++cancels;
+    }
+  }
+  bench_report("timer_cancel", "wheel", n, cancels, bench_now() - t);
+
+  while (dll_timer_wheel_size(wheel)) {
+    const uint64_t prev = wheel->now;
+    const uint64_t now  = prev + (0 == rng() % 64 ? rng() % (1 << 30) : 1 + rng() % 256);
+
+    t = bench_now();
+    const size_t count = dll_timer_advance(wheel, now, expired);
+    t_fire += bench_now() - t;
+    ++steps;
+
+    if (count != expired->objs_count) {
+      fprintf(stderr, "advance to %llu: %zu expired, %zu handed over\n",
+              (unsigned long long)now, count, expired->objs_count);
+      return 1;
+    }
+
+    for (dll_obj_t * iobj = dll_pop_front(expired); iobj; iobj = dll_pop_front(expired)) {
+      dll_timer_t * timer = (dll_timer_t *)iobj;
+
+      if (timer->expires <= prev || timer->expires > now ||
+          dll_timer_pending(wheel, timer)) {
+        fprintf(stderr, "timer for %llu expired on advance (%llu, %llu]\n",
+                (unsigned long long)timer->expires,
+                (unsigned long long)prev,
+                (unsigned long long)now);
+        return 1;
+      }
+
+      ++fired;
+      if (n / 4 > resched && 0 == rng() % 8) {
+        dll_timer_schedule(wheel, timer, now + random_delay());
+        ++resched;
+      } else {
+        dll_push_back(done, iobj);
+      }
+    }
+  }
+  bench_report("timer_expire", "wheel", n, fired, t_fire);
+
+  if (n + resched != fired + cancels || n != done->objs_count) {
+    fprintf(stderr, "%zu timers scheduled, %zu rescheduled, %zu expired, %zu cancelled\n",
+            n, resched, fired, cancels);
+    return 1;
+  }
+  fprintf(stderr, "%zu timers expired in %zu advances up to tick %llu\n",
+          fired, steps, (unsigned long long)wheel->now);
+
+  dll_free(&done);
+  dll_free(&expired);
+  dll_timer_wheel_free(&wheel);
+  free(timers);
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * \file bench_typed.c
+ *
+ * \brief Callback-driven #dll_sort , #dll_find and #dll_is_equal against the same
+ * operations generated by #DLL_DEFINE_TYPED with an inlined comparison.
+ *
+ * cc -O2 -I.. bench_typed.c -o bench_typed
+ */
+
+#include "bench.h"
+
+#include "../libdll.h"
+
+DLL_DEFINE_TYPED(dll_sz, size_t, (*a > *b) - (*a < *b))
+
+static ssize_t find_data(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  return *(size_t *)data == *(size_t *)any ? 0 : 1;
+}
+
+static ssize_t cmp_data(void * restrict a, void * restrict b, void * any, size_t index) {
+  (void)any;
+  (void)index;
+  return (*(size_t *)a > *(size_t *)b) - (*(size_t *)a < *(size_t *)b);
+}
+
+/**
+ * \b Creates a list of \p n list-objects pointing to \p values , which are filled with
+ * shuffled numbers.
+ */
+static dll_t * shuffled_list(size_t * values, size_t n, unsigned long long seed) {
+  dll_t * dll = dll_new();
+
+  bench_shuffle(values, n, seed);
+  for (size_t i = 0; n > i; ++i) {
+    dll_sz_emplace_back(dll, &values[i], LIBDLL_DESTRUCTOR_NULL);
+  }
+  return dll;
+}
+
+int main(void) {
+  static const size_t sizes[] = {1000, 100000, 1000000};
+
+  for (size_t s = 0; sizeof(sizes) / sizeof(*sizes) > s; ++s) {
+    const size_t n      = sizes[s];
+    const size_t reps   = 1 + 4000000 / n;
+    size_t *     values = malloc(n * sizeof(*values));
+    size_t *     others = malloc(n * sizeof(*others));
+    size_t       sum    = 0;
+    size_t       key    = ~0UL;
+    double       spent  = 0;
+
+    for (size_t r = 0; reps > r; ++r) {
+      dll_t * dll = shuffled_list(values, n, r + 1);
+      double  t   = bench_now();
+
+      dll_sort(dll, cmp_data, NULL);
+      spent += bench_now() - t;
+      dll_free(&dll);
+    }
+    bench_report("sort", "callback", n, n * reps, spent);
+
+    spent = 0;
+    for (size_t r = 0; reps > r; ++r) {
+      dll_t * dll = shuffled_list(values, n, r + 1);
+      double  t   = bench_now();
+
+      dll_sz_sort(dll);
+      spent += bench_now() - t;
+      dll_free(&dll);
+    }
+    bench_report("sort", "typed", n, n * reps, spent);
+
+    dll_t * a = shuffled_list(values, n, 1);
+    dll_t * b = shuffled_list(others, n, 1);
+
+    double t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += NULL != dll_find(a, find_data, &key);
+    }
+    bench_report("find", "callback", n, n * reps, bench_now() - t);
+
+    t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += NULL != dll_sz_find(a, &key);
+    }
+    bench_report("find", "typed", n, n * reps, bench_now() - t);
+
+    t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += dll_is_equal(a, b, cmp_data, NULL);
+    }
+    bench_report("is_equal", "callback", n, n * reps, bench_now() - t);
+
+    t = bench_now();
+    for (size_t r = 0; reps > r; ++r) {
+      sum += dll_sz_is_equal(a, b);
+    }
+    bench_report("is_equal", "typed", n, n * reps, bench_now() - t);
+
+    fprintf(stderr, "checksum %zu\n", sum);
+    dll_free(&a);
+    dll_free(&b);
+    free(values);
+    free(others);
+  }
+
+  return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * \file bench_wsdeque.c
+ *
+ * \brief Scaling of a recursive fork-join workload, naive fibonacci with a task per call,
+ * over per-worker #dll_wsdeque_t deques against per-worker #dll_t lists behind mutexes.
+ * Idle workers steal half of a random victim's tasks.
+ *
+ * cc -O2 -pthread -I.. bench_wsdeque.c -o bench_wsdeque
+ * ./bench_wsdeque [max threads] [fibonacci n]
+ */
+
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../libdllwsdeque.h"
+
+#define MAX_WORKERS 256
+
+typedef struct task {
+  dll_obj_t     obj;
+  struct task * parent;
+  size_t        pending;
+  uint64_t      value;
+  unsigned      n;
+} task_t;
+
+typedef struct {
+  dll_wsdeque_t * deque;
+  dll_t *         list;
+  pthread_mutex_t lock;
+} worker_t;
+
+static worker_t workers[MAX_WORKERS];
+static size_t   n_workers;
+static bool     use_wsdeque;
+static int      done;
+static uint64_t result;
+static size_t   tasks_run[MAX_WORKERS];
+
+static task_t * task_new(unsigned n, task_t * parent) {
+  task_t * t = calloc(1, sizeof(*t));
+
+  t->n      = n;
+  t->parent = parent;
+  return t;
+}
+
+static void push_task(worker_t * self, dll_obj_t * obj) {
+  if (use_wsdeque) {
+    dll_wsdeque_push(self->deque, obj);
+  } else {
+    pthread_mutex_lock(&self->lock);
+    dll_push_back(self->list, obj);
+    pthread_mutex_unlock(&self->lock);
+  }
+}
+
+static dll_obj_t * pop_task(worker_t * self) {
+  dll_obj_t * obj = NULL;
+
+  if (use_wsdeque) {
+    obj = dll_wsdeque_pop(self->deque);
+  } else {
+    pthread_mutex_lock(&self->lock);
+    obj = dll_pop_back(self->list);
+    pthread_mutex_unlock(&self->lock);
+  }
+  return obj;
+}
+
+static size_t steal_tasks(worker_t * victim, dll_t * loot) {
+  size_t count = 0;
+
+  if (use_wsdeque) {
+    return dll_wsdeque_steal_half(victim->deque, loot);
+  }
+
+  pthread_mutex_lock(&victim->lock);
+  for (size_t half = (victim->list->objs_count + 1) / 2; half > count; ++count) {
+    dll_push_back(loot, dll_pop_front(victim->list));
+  }
+  pthread_mutex_unlock(&victim->lock);
+  return count;
+}
+
+/**
+ * \b Joins finished task \p t into its parent, and the parent into its own parent once
+ * both of its children are joined.
+ */
+static void complete(task_t * t) {
+  while (t) {
+    task_t * const parent = t->parent;
+    const uint64_t value  = t->value;
+
+    free(t);
+    if (NULL == parent) {
+      result = value;
+      __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+      return;
+    }
+
+    __atomic_add_fetch(&parent->value, value, __ATOMIC_RELAXED);
+    t = 1 == __atomic_fetch_sub(&parent->pending, 1, __ATOMIC_ACQ_REL) ? parent : NULL;
+  }
+}
+
+static void run(worker_t * self, task_t * t) {
+  if (2 > t->n) {
+    t->value = t->n;
+    complete(t);
+    return;
+  }
+
+  t->pending = 2;
+  push_task(self, &task_new(t->n - 2, t)->obj);
+  push_task(self, &task_new(t->n - 1, t)->obj);
+}
+
+static void * worker(void * arg) {
+  const size_t       id    = (size_t)arg;
+  worker_t * const   self  = &workers[id];
+  dll_t *            loot  = dll_new();
+  unsigned long long seed  = id + 1;
+  size_t             count = 0;
+
+  while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+    dll_obj_t * obj = pop_task(self);
+
+    if (NULL == obj && 1 < n_workers) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+      const size_t victim = (id + 1 + (seed >> 33) % (n_workers - 1)) % n_workers;
+
+      if (steal_tasks(&workers[victim], loot)) {
+        obj = dll_pop_front(loot);
+        for (dll_obj_t * iobj = dll_pop_front(loot); iobj; iobj = dll_pop_front(loot)) {
+          push_task(self, iobj);
+        }
+      }
+    }
+
+    if (NULL == obj) {
+      sched_yield();
+      continue;
+    }
+
+    run(self, (task_t *)obj);
+    ++count;
+  }
+
+  tasks_run[id] = count;
+  dll_free(&loot);
+  return NULL;
+}
+
+static uint64_t fib(unsigned n) {
+  uint64_t a = 0;
+  uint64_t b = 1;
+
+  while (n--) {
+    const uint64_t t = a + b;
+
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+static int bench_fork_join(size_t threads, unsigned n) {
+  pthread_t tids[MAX_WORKERS];
+  size_t    tasks = 0;
+
+  n_workers = threads;
+  done      = 0;
+  for (size_t i = 0; threads > i; ++i) {
+    workers[i].deque = dll_wsdeque_new();
+    workers[i].list  = dll_new();
+    pthread_mutex_init(&workers[i].lock, NULL);
+  }
+  push_task(&workers[0], &task_new(n, NULL)->obj);
+
+  const double t = bench_now();
+  for (size_t i = 0; threads > i; ++i) {
+    pthread_create(&tids[i], NULL, worker, (void *)i);
+  }
+  for (size_t i = 0; threads > i; ++i) {
+    pthread_join(tids[i], NULL);
+    tasks += tasks_run[i];
+  }
+  bench_report("fork_join", use_wsdeque ? "wsdeque" : "mutex_dll", threads, tasks,
+               bench_now() - t);
+
+  for (size_t i = 0; threads > i; ++i) {
+    dll_wsdeque_free(&workers[i].deque);
+    dll_free(&workers[i].list);
+    pthread_mutex_destroy(&workers[i].lock);
+  }
+
+  if (fib(n) != result) {
+    fprintf(stderr, "fib(%u): %llu, expected %llu\n", n, (unsigned long long)result,
+            (unsigned long long)fib(n));
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char ** argv) {
+  const long     cpus    = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t         threads = 1 < argc ? strtoul(argv[1], NULL, 10) : (size_t)cpus;
+  const unsigned n       = 2 < argc ? (unsigned)strtoul(argv[2], NULL, 10) : 27;
+
+  if (0 == threads || MAX_WORKERS < threads) {
+    threads = MAX_WORKERS < threads ? MAX_WORKERS : 1;
+  }
+
+  for (size_t t = 1; threads >= t; t = threads > t && threads < t * 2 ? threads : t * 2) {
+    use_wsdeque = false;
+    if (bench_fork_join(t, n)) {
+      return 1;
+    }
+    use_wsdeque = true;
+    if (bench_fork_join(t, n)) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
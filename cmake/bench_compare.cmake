@@ -0,0 +1,110 @@
+# Runs benchmark programs and compares their throughput against a stored baseline.
+#
+# cmake -DPROGRAMS=<program>|<program>... -DMAX_SIZE=<n> -DOUTPUT=<file> [-DRUNS=<n>]
+#       [-DBASELINE=<file> -DTHRESHOLD=<percent> -DKEYS=<regex> -DMIN_SIZE=<n>]
+#       -P bench_compare.cmake
+#
+# Every program is run RUNS times with MAX_SIZE as its argument and its JSON lines are
+# written to OUTPUT, the best of the runs counts. Without BASELINE that is all, OUTPUT
+# becomes the new baseline. With it, every
+# measurement of a benchmark matching KEYS, of a libdll implementation, on at least
+# MIN_SIZE list-objects, is looked up in BASELINE by its bench, impl and size, and the
+# script fails if any of them is more than THRESHOLD percent slower. Runs on smaller lists
+# take microseconds and are too noisy to compare.
+
+cmake_minimum_required(VERSION 3.19)
+
+if(NOT PROGRAMS OR NOT MAX_SIZE OR NOT OUTPUT)
+  message(FATAL_ERROR "PROGRAMS, MAX_SIZE and OUTPUT are required")
+endif()
+
+if(NOT RUNS)
+  set(RUNS 3)
+endif()
+
+string(REPLACE "|" ";" PROGRAMS "${PROGRAMS}")
+file(WRITE ${OUTPUT} "")
+foreach(_run RANGE 1 ${RUNS})
+  foreach(_program ${PROGRAMS})
+    execute_process(COMMAND ${_program} ${MAX_SIZE}
+                    OUTPUT_VARIABLE _output
+                    RESULT_VARIABLE _result)
+    if(NOT _result EQUAL 0)
+      message(FATAL_ERROR "${_program} failed: ${_result}")
+    endif()
+    file(APPEND ${OUTPUT} "${_output}")
+  endforeach()
+endforeach()
+
+if(NOT BASELINE)
+  message(STATUS "Benchmark results stored in ${OUTPUT}")
+  return()
+endif()
+if(NOT EXISTS ${BASELINE})
+  message(FATAL_ERROR "No baseline ${BASELINE}, build the bench_baseline target first, "
+                      "on the commit to compare against")
+endif()
+if(NOT THRESHOLD)
+  set(THRESHOLD 10)
+endif()
+if(NOT KEYS)
+  set(KEYS ".")
+endif()
+if(NOT MIN_SIZE)
+  set(MIN_SIZE 10000)
+endif()
+
+# Reads JSON lines of _file into variables _prefix_<bench>/<impl>/<size> holding the
+# integral part of their best ops_per_sec, and the list of their names into _prefix.
+function(read_results _file _prefix)
+  file(STRINGS ${_file} _lines REGEX "^{")
+  set(_keys "")
+
+  foreach(_line ${_lines})
+    string(JSON _bench GET "${_line}" bench)
+    string(JSON _impl GET "${_line}" impl)
+    string(JSON _size GET "${_line}" size)
+    string(JSON _ops_per_sec GET "${_line}" ops_per_sec)
+
+    if(_bench MATCHES "${KEYS}" AND _impl MATCHES "^libdll" AND
+       _size GREATER_EQUAL MIN_SIZE)
+      string(REGEX REPLACE "\\..*$" "" _ops_per_sec "${_ops_per_sec}")
+      set(_key "${_bench}/${_impl}/${_size}")
+      if(NOT DEFINED _best_${_key})
+        list(APPEND _keys ${_key})
+        set(_best_${_key} ${_ops_per_sec})
+      elseif(_ops_per_sec GREATER _best_${_key})
+        set(_best_${_key} ${_ops_per_sec})
+      endif()
+      set(${_prefix}_${_key} ${_best_${_key}} PARENT_SCOPE)
+    endif()
+  endforeach()
+
+  set(${_prefix} ${_keys} PARENT_SCOPE)
+endfunction()
+
+read_results(${BASELINE} baseline)
+read_results(${OUTPUT} current)
+
+set(_regressions 0)
+foreach(_key ${current})
+  if(NOT DEFINED baseline_${_key})
+    continue()
+  endif()
+
+  set(_was ${baseline_${_key}})
+  set(_now ${current_${_key}})
+  math(EXPR _change "(${_now} - ${_was}) * 100 / (${_was} + 1)")
+
+  if(_change LESS -${THRESHOLD})
+    message(WARNING "${_key}: ${_was} -> ${_now} ops/s (${_change}%)")
+    math(EXPR _regressions "${_regressions} + 1")
+  else()
+    message(STATUS "${_key}: ${_was} -> ${_now} ops/s (${_change}%)")
+  endif()
+endforeach()
+
+if(_regressions GREATER 0)
+  message(FATAL_ERROR "${_regressions} benchmarks regressed over ${THRESHOLD}%")
+endif()
+message(STATUS "No benchmark regressed over ${THRESHOLD}% against ${BASELINE}")
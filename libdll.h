@@ -31,6 +31,16 @@
 #include <string.h>
 #include <sys/types.h>
 
+#ifdef LIBDLL_PROBES
+#  include <sys/sdt.h>
+#endif /* LIBDLL_PROBES */
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
 //
 // ----------------------------
 // libdll specifications and macroses
@@ -49,6 +59,140 @@
 
 #endif /* LIBDLL_UNSAFE_USAGE */
 
+#ifdef LIBDLL_STATS
+#  undef LIBDLL_STATS
+
+/**
+ * Counting operations, walked list-objects, callback calls, allocations, frees and sort
+ * comparisons of each list in its \c stats , see #dll_stats_dump .
+ *
+ * \note Without it the counting compiles to nothing and lists have no \c stats .
+ */
+#  define LIBDLL_STATS 1
+
+#endif /* LIBDLL_STATS */
+
+#ifdef LIBDLL_PROBES
+#  undef LIBDLL_PROBES
+
+/**
+ * Placing USDT probes of the \c libdll provider, for \c perf and \c bpftrace , at entry
+ * and return of list operations. Requires \c <sys/sdt.h> from SystemTap. Every probe
+ * gets the list and its count of list-objects, then:
+ * - \c push_front_entry , \c push_front_return , \c push_back_entry ,
+ * \c push_back_return , \c unlink_entry , \c unlink_return : the list-object;
+ * - \c pop_front_entry , \c pop_back_entry : nothing else;
+ * - \c pop_front_return , \c pop_back_return : the popped list-object;
+ * - \c insert_entry : the position; \c insert_return : count of list-objects walked;
+ * - \c sort_entry : the comparator; \c sort_return : count of comparisons so far, see
+ * #LIBDLL_STATS , 0 without it;
+ * - \c clear_entry , \c clear_return , \c free_entry , \c free_return : nothing else.
+ *
+ * \note Without it probes compile to nothing.
+ */
+#  define LIBDLL_PROBES 1
+
+#endif /* LIBDLL_PROBES */
+
+#ifdef LIBDLL_FINGERPRINT
+#  undef LIBDLL_FINGERPRINT
+
+/**
+ * Keeping an order-sensitive hash of data bytes of list-objects in each list, updated in
+ * O(1) on each insertion and removal, so #dll_is_equal rejects unequal lists without
+ * walking them, see #dll_fingerprint . List-objects keep the hash of their own data.
+ *
+ * \note Without it lists have no fingerprint and the hashing compiles to nothing.
+ */
+#  define LIBDLL_FINGERPRINT 1
+
+#endif /* LIBDLL_FINGERPRINT */
+
+#ifdef LIBDLL_SORTED
+#  undef LIBDLL_SORTED
+
+/**
+ * Enabling the sorted mode of lists, see #dll_set_sorted , with a skip-list overlay for
+ * O(log n) expected ordered insertion and search.
+ *
+ * \note Without it lists have no comparator and overlay, and the sorted-mode functions
+ * fail.
+ */
+#  define LIBDLL_SORTED 1
+
+#endif /* LIBDLL_SORTED */
+
+#ifdef LIBDLL_COMPACT
+#  undef LIBDLL_COMPACT
+
+/**
+ * Enabling relocation of list-objects into storage blocks by #dll_compact and
+ * #dll_compact_step .
+ *
+ * \note Without it lists keep no state of a compaction pass and both functions fail.
+ */
+#  define LIBDLL_COMPACT 1
+
+#endif /* LIBDLL_COMPACT */
+
+#ifdef LIBDLL_MEMORY
+#  undef LIBDLL_MEMORY
+
+/**
+ * Keeping counters of data bytes and storage blocks in each list, updated in O(1) on
+ * each insertion and removal, see #dll_memory_usage .
+ *
+ * \note Without it lists have no counters and the accounting compiles to nothing.
+ */
+#  define LIBDLL_MEMORY 1
+
+#endif /* LIBDLL_MEMORY */
+
+#ifndef LIBDLL_PREFETCH_DISTANCE
+/**
+ * Count of list-objects prefetched ahead of the current one by #dll_foreach , #dll_find ,
+ * #dll_remove , #dll_map and #dll_is_equal , 0 disables prefetching.
+ *
+ * \note Prefetching only pays off for long lists whose list-objects are scattered over
+ * the heap, for short or compacted lists it is extra work, so it is off unless defined,
+ * e.g. as 2. Measure it with bench/bench_prefetch.c .
+ */
+#  define LIBDLL_PREFETCH_DISTANCE 0
+#endif /* LIBDLL_PREFETCH_DISTANCE */
+
+#ifndef LIBDLL_BATCH_SIZE
+/**
+ * Maximum count of list-objects data gathered for one call of a
+ * #dll_callback_batch_fn_t callback by #dll_foreach_batch , #dll_find_batch and
+ * #dll_remove_batch .
+ */
+#  define LIBDLL_BATCH_SIZE 16
+#endif /* LIBDLL_BATCH_SIZE */
+
+#ifndef LIBDLL_BLOCK_SIZE
+/**
+ * Size in bytes of storage blocks into which #dll_compact relocates list-objects. Must be
+ * a power of two, blocks are aligned to their size.
+ */
+#  define LIBDLL_BLOCK_SIZE (64UL * 1024UL)
+#endif /* LIBDLL_BLOCK_SIZE */
+
+#ifndef LIBDLL_MALLOC_OVERHEAD
+/**
+ * Upper bound of bytes \c malloc spends on bookkeeping and alignment of one allocation,
+ * which #dll_memory_usage adds for each allocation made by a list.
+ */
+#  define LIBDLL_MALLOC_OVERHEAD 32UL
+#endif /* LIBDLL_MALLOC_OVERHEAD */
+
+#ifndef LIBDLL_SKIP_LEVELS
+/**
+ * Maximum count of levels of the skip-list overlay, which #dll_set_sorted lists keep over
+ * their list-objects.
+ */
+#  define LIBDLL_SKIP_LEVELS 16
+#endif /* LIBDLL_SKIP_LEVELS */
+
 /**
  * Use this macros as \c destructor argument for #dll_new_obj if you do not
  * allocate anything inside the \c data , but the \c data itself was allocated before you
@@ -62,6 +206,12 @@
  */
 #define LIBDLL_DESTRUCTOR_NULL ((dll_callback_destructor_fn_t)NULL)
 
+/**
+ * Use this macros as \c fn_cmp argument for #dll_is_equal to compare list-objects by
+ * their \c size and \c size bytes of their \c data .
+ */
+#define LIBDLL_CMP_BYTES ((dll_callback_ext_fn_t)-0x1UL)
+
 //
 // ----------------------------
 // Macros definitions
@@ -82,6 +232,76 @@
 
 #define __dll_inline static inline
 
+#if defined(__GNUC__) || defined(__clang__)
+#  define __dll_prefetch(_addr) __builtin_prefetch(_addr)
+#else
+#  define __dll_prefetch(_addr) ((void)(_addr))
+#endif
+
+#ifdef LIBDLL_STATS
+/**
+ * Adds \p _n to the \p _counter of \p _dll stats. Counters of const lists are counted
+ * as well.
+ */
+#  define __dlli_stat(_dll, _counter, _n)                                                \
+    ((void)(((dll_t *)(_dll))->stats._counter += (_n)))
+
+/**
+ * Updates the maximum length of \p _dll in its stats.
+ */
+#  define __dlli_stat_len(_dll)                                                          \
+    ((void)((_dll)->stats.max_len < (_dll)->objs_count &&                                \
+            ((_dll)->stats.max_len = (_dll)->objs_count)))
+
+/**
+ * Reads the \p _counter of \p _dll stats, 0 without #LIBDLL_STATS .
+ */
+#  define __dlli_stat_get(_dll, _counter) ((_dll)->stats._counter)
+#else
+#  define __dlli_stat(_dll, _counter, _n) ((void)0)
+#  define __dlli_stat_len(_dll)           ((void)0)
+#  define __dlli_stat_get(_dll, _counter) ((size_t)0)
+#endif /* LIBDLL_STATS */
+
+#ifdef LIBDLL_PROBES
+/**
+ * Fires USDT probe \p _name of the \c libdll provider with list \p _dll and its count of
+ * list-objects, see #LIBDLL_PROBES .
+ */
+#  define __dlli_probe(_name, _dll) DTRACE_PROBE2(libdll, _name, _dll, (_dll)->objs_count)
+
+/**
+ * Fires USDT probe \p _name as #__dlli_probe does, with one more argument \p _arg .
+ */
+#  define __dlli_probe_arg(_name, _dll, _arg)                                            \
+    DTRACE_PROBE3(libdll, _name, _dll, (_dll)->objs_count, _arg)
+#else
+#  define __dlli_probe(_name, _dll)           ((void)0)
+#  define __dlli_probe_arg(_name, _dll, _arg) ((void)0)
+#endif /* LIBDLL_PROBES */
+
+#ifdef LIBDLL_FINGERPRINT
+/**
+ * Marks the fingerprint of \p _dll to be recomputed, after its list-objects were
+ * relinked in a new order.
+ */
+#  define __dlli_fp_stale(_dll) ((void)((_dll)->__fp_stale = true))
+#else
+#  define __dlli_fp_stale(_dll) ((void)0)
+#endif /* LIBDLL_FINGERPRINT */
+
+/**
+ * Access the next list-object after \p _obj in the order of \p _dll list, respecting
+ * the direction in which #dll_reverse left it. Also usable as an lvalue.
+ */
+#define __dlli_next(_dll, _obj) (*((_dll)->__reversed ? &(_obj)->prev : &(_obj)->next))
+
+/**
+ * Access the previous list-object before \p _obj in the order of \p _dll list,
+ * respecting the direction in which #dll_reverse left it. Also usable as an lvalue.
+ */
+#define __dlli_prev(_dll, _obj) (*((_dll)->__reversed ? &(_obj)->next : &(_obj)->prev))
+
 //
 // ----------------------------
 // Data structure definitions
@@ -135,6 +355,23 @@ typedef void * (*dll_callback_mapper_fn_t)(void * restrict obj_data,
                                            void * restrict any,
                                            size_t index);
 
+/**
+ * A callback typedef for batch variants of traversal functions, like #dll_foreach_batch ,
+ * which receives data of up to #LIBDLL_BATCH_SIZE consecutive list-objects at once.
+ *
+ * \param objs_data data of \p count consecutive list-objects.
+ * \param results comparing result to be set for each of \p objs_data , same as the one
+ * returned by #dll_callback_fn_t ; \c NULL for #dll_foreach_batch .
+ * \param count count of \p objs_data , from 1 to #LIBDLL_BATCH_SIZE .
+ * \param any an any additional data.
+ * \param index an index of the first of \p objs_data .
+ */
+typedef void (*dll_callback_batch_fn_t)(void ** restrict objs_data,
+                                        ssize_t * restrict results,
+                                        size_t count,
+                                        void * restrict any,
+                                        size_t index);
+
 /**
  * A list-object structure.
  *
@@ -155,8 +392,128 @@ typedef struct __s_dll_obj {
 
   /** a \c data size. */
   size_t size;
+#ifdef LIBDLL_FINGERPRINT
+  /** a hash of \c size and \c data taken when linked, see #dll_fingerprint . */
+  uint64_t __fp_hash;
+#endif /* LIBDLL_FINGERPRINT */
 } dll_obj_t;
 
+/**
+ * A callback function for #dll_compact , called for each relocated list-object.
+ *
+ * \param old_obj previous address of the list-object, it must not be dereferenced.
+ * \param new_obj new address of the list-object.
+ * \param any an any additional data.
+ */
+typedef void (*dll_callback_relocate_fn_t)(dll_obj_t * old_obj,
+                                           dll_obj_t * new_obj,
+                                           void * restrict any);
+
+/**
+ * A header of a storage block of list-objects, see #dll_compact .
+ *
+ * \typedef dll_block_t
+ */
+typedef struct {
+  /** a count of list-objects in the block which are not freed yet. */
+  size_t __live;
+  /** a count of list-object slots in the block handed out so far. */
+  size_t __used;
+  /** a list accounting the block as its own for #dll_memory_usage , or \c NULL . */
+  void * __owner;
+  /** a count of list-objects in the block linked to \c __owner . */
+  size_t __owner_objs;
+} dll_block_t;
+
+/**
+ * A tower of the skip-list overlay over list-objects of a sorted list, see
+ * #dll_set_sorted .
+ *
+ * \typedef dll_skip_t
+ */
+typedef struct __s_dll_skip {
+  /** a list-object the tower stands on, \c NULL for the head tower of the overlay. */
+  dll_obj_t * __obj;
+  /** a count of levels of the tower. */
+  size_t __levels;
+  /** next towers on each level. */
+  struct __s_dll_skip * __next[];
+} dll_skip_t;
+
+/**
+ * A reclaimer of list-objects detached from lists, see #dll_set_reclaimer .
+ *
+ * \note Lists hand list-objects over with lock-free pushes, so any count of threads may
+ * hand them over, but only one thread at a time may call #dll_reclaim_step .
+ *
+ * \typedef dll_reclaimer_t
+ */
+typedef struct {
+  /** chains of list-objects handed over by lists, linked through \c next . */
+  dll_obj_t * __pending;
+  /** list-objects taken from \c __pending , which are not freed yet. */
+  dll_obj_t * __current;
+} dll_reclaimer_t;
+
+/**
+ * Operation counters of a list, see #LIBDLL_STATS .
+ *
+ * \typedef dll_stats_t
+ */
+typedef struct {
+  /** a count of insertions, removals, searches and sorts. */
+  size_t ops;
+  /** a count of list-objects walked over by searches and positioning. */
+  size_t steps;
+  /** a count of callback-function calls by traversals and searches. */
+  size_t calls;
+  /** a count of list-objects allocated by emplace functions. */
+  size_t allocs;
+  /** a count of list-objects destroyed by #dll_delete and #dll_clear . */
+  size_t frees;
+  /** a count of comparator calls by sorts. */
+  size_t cmps;
+  /** the maximum count of list-objects the list had. */
+  size_t max_len;
+} dll_stats_t;
+
+/**
+ * Memory footprint of a list, see #dll_memory_usage .
+ *
+ * \typedef dll_memory_t
+ */
+typedef struct {
+  /** a count of list-objects. */
+  size_t objs;
+  /** bytes of the list-objects themselves, wherever they live. */
+  size_t obj_bytes;
+  /** a sum of \c size of the list-objects. */
+  size_t data_bytes;
+  /** a count of the list-objects living in storage blocks, see #dll_compact . */
+  size_t block_objs;
+  /** bytes of storage block slots taken by \c block_objs list-objects. */
+  size_t block_used_bytes;
+  /**
+   * an upper bound of bytes of storage blocks reserved for \c block_objs list-objects:
+   * each block counted once while the list accounts it as its own, and a whole block
+   * for each list-object in a block accounted by another list.
+   */
+  size_t block_reserved_bytes;
+  /** bytes of the skip-list overlay of a sorted list, see #dll_set_sorted . */
+  size_t skip_bytes;
+  /**
+   * an upper bound of bytes spent by \c malloc on the list, its list-objects allocated
+   * on their own and the towers of the overlay, see #LIBDLL_MALLOC_OVERHEAD .
+   */
+  size_t alloc_overhead_bytes;
+  /**
+   * the list, its list-objects allocated on their own, reserved storage blocks, data,
+   * the overlay and allocator overhead together. An upper bound as
+   * \c block_reserved_bytes is.
+   */
+  size_t total_bytes;
+} dll_memory_t;
+
 /**
  * A doubly linked list structure.
  *
@@ -169,8 +526,106 @@ typedef struct {
   dll_obj_t * restrict tail;
   /** a counter of list-objects in list. */
   size_t objs_count;
+  /**
+   * \c true when the \c next and \c prev links of all list-objects are swapped, so
+   * \c prev points to the next list-object. Toggled by #dll_reverse .
+   */
+  bool __reversed;
+  /** a reclaimer to which list-objects are handed over instead of freeing them. */
+  dll_reclaimer_t * restrict __reclaimer;
+  /** the newest alive snapshot of the list, see #dll_snapshot . */
+  struct __s_dll_snapshot * __snapshot;
+#ifdef LIBDLL_COMPACT
+  /** the next list-object to be relocated by a running #dll_compact_step pass. */
+  dll_obj_t * restrict __compact_next;
+  /** a storage block being filled by a running #dll_compact_step pass. */
+  dll_block_t * restrict __compact_block;
+#endif /* LIBDLL_COMPACT */
+#ifdef LIBDLL_SORTED
+  /** a comparator keeping the list sorted, set by #dll_set_sorted . */
+  dll_callback_ext_fn_t __sorted_cmp;
+  /** any data to be passed to \c __sorted_cmp . */
+  void * __sorted_any;
+  /** the head tower of the skip-list overlay, \c NULL until it is built. */
+  dll_skip_t * __skip;
+  /** bytes allocated for towers of the skip-list overlay. */
+  size_t __skip_bytes;
+#endif /* LIBDLL_SORTED */
+#ifdef LIBDLL_MEMORY
+  /** a sum of \c size of list-objects in list. */
+  size_t __data_bytes;
+  /** a counter of list-objects in list living in storage blocks. */
+  size_t __block_objs;
+  /** a counter of storage blocks the list accounts as its own. */
+  size_t __blocks;
+  /** a counter of list-objects in list living in storage blocks of other lists. */
+  size_t __foreign_objs;
+#endif /* LIBDLL_MEMORY */
+#ifdef LIBDLL_STATS
+  /** operation counters of the list. */
+  dll_stats_t stats;
+#endif /* LIBDLL_STATS */
+#ifdef LIBDLL_FINGERPRINT
+  /** order-sensitive hash of data of list-objects, see #dll_fingerprint . */
+  uint64_t __fingerprint;
+  /** \c true when \c __fingerprint has to be recomputed. */
+  bool __fp_stale;
+#endif /* LIBDLL_FINGERPRINT */
 } dll_t;
 
+/**
+ * A copy-on-write snapshot of a list, see #dll_snapshot .
+ *
+ * \note Until the list is modified, the snapshot shares its list-objects. The first
+ * modification copies all the list-objects into storage blocks owned by the snapshot,
+ * while their data stays shared.
+ *
+ * \typedef dll_snapshot_t
+ */
+typedef struct __s_dll_snapshot {
+  /** a head of the snapshot. */
+  dll_obj_t * head;
+  /** a tail of the snapshot. */
+  dll_obj_t * tail;
+  /** a counter of list-objects in the snapshot. */
+  size_t objs_count;
+  /** \c true while list-objects are shared with the list. */
+  bool __shared;
+  /** direction of the shared list-objects, as \c dll_t.__reversed . */
+  bool __reversed;
+  /** a count of #dll_snapshot calls which returned this snapshot and weren't freed. */
+  size_t __refs;
+  /** the list, \c NULL once it is freed. */
+  dll_t * __dll;
+  /** the previous alive snapshot of the same list. */
+  struct __s_dll_snapshot * __older;
+  /** the next alive snapshot of the same list. */
+  struct __s_dll_snapshot * __newer;
+  /** storage blocks with copied list-objects in order, terminated by \c NULL . */
+  dll_block_t ** __segments;
+  /**
+   * list-objects destroyed by the list while the snapshot was alive, linked through
+   * \c next . Their data may be still seen through the snapshot.
+   */
+  dll_obj_t * __retired;
+} dll_snapshot_t;
+
+/**
+ * A snapshot iterator structure, see #dll_snapshot_iterator .
+ *
+ * \typedef dll_snapshot_iterator_t
+ */
+typedef struct {
+  /** a current list-object. */
+  dll_obj_t * __obj;
+  /** iterated snapshot. */
+  const dll_snapshot_t * __snap;
+  /** index of \c __obj . */
+  size_t __index;
+  /** \c true when \c __obj is a copy owned by the snapshot. */
+  bool __copied;
+} dll_snapshot_iterator_t;
+
 /**
  * A list-object iterator structure.
  *
@@ -287,6 +742,9 @@ __dll_inline dll_obj_t * dll_pop_back(dll_t * restrict dll);
 /**
  * \b Erases all elements from the \p dll list.
  *
+ * \note The whole chain of list-objects is detached in O(1) and then walked only once
+ * to call destructors and free list-objects, without relinking them one by one.
+ *
  * \attention After this call, #dll_size returns zero. Any pointers referring to contained
  * elements can be invalid if you specified a \c destructor callback-function for each
  * individual list-object, alsot lost memory leaks errors can occur as well if you don't
@@ -547,13 +1005,71 @@ __dll_inline size_t dll_remove(dll_t * restrict dll,
                                void * restrict any);
 
 /**
- * \b Reverses the order of the list-objects in the list.
+ * \b Moves list-objects of \p src to the back of \p out_true if \p fn_cmp returns a zero
+ * value for them, or to the back of \p out_false otherwise.
+ *
+ * \note Done in one pass by relinking only, without allocations. List-objects keep their
+ * relative order in both lists. \p fn_cmp must not take snapshots of the lists.
+ *
+ * \param src list to be partitioned.
+ * \param fn_cmp comparator for list-objects data and given \p any data.
+ * \param any any additional data to be given to the second argument of \p fn_cmp .
+ * \param out_true list for matching list-objects, or \c NULL to leave them in \p src .
+ * \param out_false list for the rest of list-objects, or \c NULL to leave them in
+ * \p src .
+ *
+ * \return count of list-objects for which \p fn_cmp returned a zero value, 0 if the
+ * list-objects shared by a snapshot of any of the lists couldn't be copied, then nothing
+ * is moved.
+ */
+__dll_inline size_t dll_partition(dll_t * restrict  src,
+                                  dll_callback_fn_t fn_cmp,
+                                  void * restrict   any,
+                                  dll_t * restrict  out_true,
+                                  dll_t * restrict  out_false);
+
+/**
+ * \b Moves list-objects of \p src for which \p fn_cmp returns a zero value to the back
+ * of \p out . Same as #dll_remove , but list-objects are kept instead of deleted.
+ *
+ * \param src list.
+ * \param fn_cmp comparator for list-objects data and given \p any data.
+ * \param any any additional data to be given to the second argument of \p fn_cmp .
+ * \param out list for moved list-objects.
+ *
+ * \return count of moved list-objects.
+ */
+__dll_inline size_t dll_remove_if_into(dll_t * restrict  src,
+                                       dll_callback_fn_t fn_cmp,
+                                       void * restrict   any,
+                                       dll_t * restrict  out);
+
+/**
+ * \b Reverses the order of the list-objects in the list in O(1).
+ *
+ * \note Only the \c head and \c tail of \p dll are swapped and the list is marked as
+ * reversed, so all the list-objects keep their identity and data. Every libdll function
+ * respects this direction, but \c next and \c prev links of list-objects are swapped
+ * while the list is reversed. Use #dll_reverse_relink if you walk the links by yourself.
+ *
+ * \param dll list to be reversed.
+ *
+ * \return true on succes, false otherwise
+ */
+__dll_inline bool dll_reverse(dll_t * restrict const dll);
+
+/**
+ * \b Reverses the order of the list-objects in the list by relinking every list-object.
+ *
+ * \note Costs O(n) unless \p dll was reversed with #dll_reverse before, but after this
+ * call \c next and \c prev links of all list-objects follow the order of the list
+ * again. List-objects keep their identity and data.
  *
  * \param dll list to be reversed.
  *
  * \return true on succes, false otherwise
  */
-__dll_inline bool dll_reverse(const dll_t * restrict const dll);
+__dll_inline bool dll_reverse_relink(dll_t * restrict const dll);
 
 /**
  * \b Searches for specific \p data via \p fn_search when it returns zero value.
@@ -583,6 +1099,48 @@ __dll_inline void ** dll_map(const dll_t * restrict const dll,
                              dll_callback_mapper_fn_t mapper,
                              void * restrict any);
 
+/**
+ * \b Batch variant of #dll_foreach : calls \p fn once per up to #LIBDLL_BATCH_SIZE
+ * consecutive list-objects with an array of their data.
+ *
+ * \param dll list.
+ * \param fn callback-function, \c results argument of it is \c NULL .
+ * \param any any data to be passed to \p fn .
+ *
+ * \return \c true on success, \c false otherwise.
+ */
+__dll_inline bool dll_foreach_batch(const dll_t * restrict dll,
+                                    dll_callback_batch_fn_t fn,
+                                    void * restrict any);
+
+/**
+ * \b Batch variant of #dll_find : calls \p fn_search once per up to #LIBDLL_BATCH_SIZE
+ * consecutive list-objects, until it sets a zero result for any of them.
+ *
+ * \param dll list.
+ * \param fn_search callback-function to set a result for each given data.
+ * \param any any data to be passed to \p fn_search .
+ *
+ * \return first occurrence of searched data in list \p dll , \c NULL otherwise.
+ */
+__dll_inline void * dll_find_batch(const dll_t * restrict dll,
+                                   dll_callback_batch_fn_t fn_search,
+                                   void * restrict any);
+
+/**
+ * \b Batch variant of #dll_remove : calls \p fn_cmp once per up to #LIBDLL_BATCH_SIZE
+ * consecutive list-objects and removes the ones it set a zero result for.
+ *
+ * \param dll list.
+ * \param fn_cmp callback-function to set a result for each given data.
+ * \param any any data to be passed to \p fn_cmp .
+ *
+ * \return count of removed objects from list \p dll .
+ */
+__dll_inline size_t dll_remove_batch(dll_t * restrict dll,
+                                     dll_callback_batch_fn_t fn_cmp,
+                                     void * restrict any);
+
 /**
  * \b Removes all consecutive duplicate list-objects from the list.
  *
@@ -600,8 +1158,8 @@ __dll_inline size_t dll_unique(dll_t * restrict dll,
                                void *                any);
 
 /**
- * \b Sorts all the list-objects via \p fn_sort in \p dll list using a recursive merge
- * sort.
+ * \b Sorts all the list-objects via \p fn_sort in \p dll list using an iterative merge
+ * sort. Equal list-objects keep their order.
  *
  * \note if list empty or has only 1 list-object then it's consider as sorted and returns
  * \c true .
@@ -615,11 +1173,141 @@ __dll_inline size_t dll_unique(dll_t * restrict dll,
 __dll_inline bool
     dll_sort(dll_t * restrict dll, dll_callback_ext_fn_t fn_sort, void * any);
 
+/**
+ * \b Places the \p k smallest list-objects in \p dll list, compared via \p fn_sort , in
+ * sorted order at the front of the list in O(n log k). The rest of list-objects keep
+ * their relative order after them.
+ *
+ * \note if \p k isn't less than the list size then the whole list is sorted by #dll_sort
+ * .
+ *
+ * \param dll list to be partially sorted.
+ * \param k count of list-objects to be sorted.
+ * \param fn_sort callback-function to compare list-objects, as for #dll_sort .
+ * \param any any data to be passed to fn_sort callback.
+ *
+ * \returns \c true on success, \c false otherwise.
+ */
+__dll_inline bool dll_partial_sort(dll_t * restrict      dll,
+                                   size_t                k,
+                                   dll_callback_ext_fn_t fn_sort,
+                                   void *                any);
+
+/**
+ * \b Rearranges list-objects in \p dll list, compared via \p fn_sort , so the one at
+ * index \p n is the one which would be there if the list was sorted, with no greater
+ * list-objects before it and no smaller ones after it. Expected O(n) quickselect.
+ *
+ * \param dll list to be rearranged.
+ * \param n index of list-object to be selected.
+ * \param fn_sort callback-function to compare list-objects, as for #dll_sort .
+ * \param any any data to be passed to fn_sort callback.
+ *
+ * \returns selected list-object, or \c NULL if \p n is out of the list or on failure.
+ */
+__dll_inline dll_obj_t * dll_nth_element(dll_t * restrict      dll,
+                                         size_t                n,
+                                         dll_callback_ext_fn_t fn_sort,
+                                         void *                any);
+
+/**
+ * \b Turns on the sorted mode of \p dll list: sorts it via \p fn_cmp and keeps
+ * \p fn_cmp in the list for #dll_insert_sorted , #dll_emplace_sorted ,
+ * #dll_lower_bound , #dll_upper_bound and #dll_foreach_range .
+ *
+ * \note Those functions search through a skip-list overlay over the list-objects in
+ * O(log n) expected. The overlay is built on the first search and kept up to date by
+ * them and by unlinking or deleting list-objects. Any other function which adds or
+ * reorders list-objects drops the overlay, and the list must be sorted by \p fn_cmp
+ * again before the next search. Plain iteration works as for any other list.
+ *
+ * \note The sorted mode is available only if #LIBDLL_SORTED is defined.
+ *
+ * \param dll list.
+ * \param fn_cmp callback-function to compare list-objects, as for #dll_sort , or \c NULL
+ * to turn the sorted mode off.
+ * \param any any data to be passed to \p fn_cmp .
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_SORTED
+ */
+__dll_inline bool
+    dll_set_sorted(dll_t * restrict dll, dll_callback_ext_fn_t fn_cmp, void * any);
+
+/**
+ * \b Inserts \p obj list-object into the sorted \p dll list after all the list-objects
+ * which are not greater than it.
+ *
+ * \param dll list in the sorted mode, see #dll_set_sorted .
+ * \param obj list-object.
+ *
+ * \return \p obj on success, \c NULL otherwise or without #LIBDLL_SORTED
+ */
+__dll_inline dll_obj_t *
+    dll_insert_sorted(dll_t * restrict dll, dll_obj_t * restrict obj);
+
+/**
+ * \b Creates a new list-object with provided \p data and inserts it into the sorted
+ * \p dll list via #dll_insert_sorted .
+ *
+ * \param dll list in the sorted mode, see #dll_set_sorted .
+ * \param data any data.
+ * \param size \p data size.
+ * \param destructor \destructor_description
+ *
+ * \return created list-object on success, \c NULL otherwise or without #LIBDLL_SORTED
+ */
+__dll_inline dll_obj_t * dll_emplace_sorted(dll_t * restrict dll,
+                                            void * restrict data,
+                                            size_t                       size,
+                                            dll_callback_destructor_fn_t destructor);
+
+/**
+ * \b Searches for the first list-object in the sorted \p dll list which is not less
+ * than \p key .
+ *
+ * \param dll list in the sorted mode, see #dll_set_sorted .
+ * \param key data to be passed as the second argument of the list comparator.
+ *
+ * \return found list-object, \c NULL if there is no such or without #LIBDLL_SORTED
+ */
+__dll_inline dll_obj_t * dll_lower_bound(dll_t * restrict dll, void * key);
+
+/**
+ * \b Searches for the first list-object in the sorted \p dll list which is greater than
+ * \p key .
+ *
+ * \param dll list in the sorted mode, see #dll_set_sorted .
+ * \param key data to be passed as the second argument of the list comparator.
+ *
+ * \return found list-object, \c NULL if there is no such or without #LIBDLL_SORTED
+ */
+__dll_inline dll_obj_t * dll_upper_bound(dll_t * restrict dll, void * key);
+
+/**
+ * \b Calls \p fn for each list-object of the sorted \p dll list which is not less than
+ * \p from and less than \p to .
+ *
+ * \param dll list in the sorted mode, see #dll_set_sorted .
+ * \param from lower key of the range, or \c NULL to start from the head of the list.
+ * \param to upper key of the range, or \c NULL to go to the tail of the list.
+ * \param fn callback-function, its \c index argument counts from the range start.
+ * \param any any data to be passed to \p fn .
+ *
+ * \return count of list-objects in the range, 0 without #LIBDLL_SORTED
+ */
+__dll_inline size_t dll_foreach_range(dll_t * restrict  dll,
+                                      void *            from,
+                                      void *            to,
+                                      dll_callback_fn_t fn,
+                                      void * restrict   any);
+
 /**
  * \b Compares two lists if they are not equals.
  *
  * \note if \p fn_cmp is not provided then list-objects will be compared by it's \c size
- * and \c data .
+ * and \c data . With #LIBDLL_CMP_BYTES they are compared by \c size and contents of
+ * \c data . Without a comparator or with #LIBDLL_CMP_BYTES , lists with different
+ * fingerprints are unequal without walking them, see #LIBDLL_FINGERPRINT .
  *
  * \param dll_a first list to compare
  * \param dll_b second list to compare
@@ -675,29 +1363,286 @@ __dll_inline bool dll_free_obj(dll_obj_t * restrict * restrict obj);
  */
 __dll_inline bool dll_free(dll_t * restrict * restrict dll);
 
-/*
- * ----------------------------
- * Function definitions
- * ----------------------------
+/**
+ * \b Creates a new and empty reclaimer for list-objects detached from lists.
+ *
+ * \return allocated memory for new reclaimer, \c NULL otherwise
  */
+__dll_inline dll_reclaimer_t * dll_reclaimer_new(void);
 
-__dll_inline dll_t * dll_new(void) {
-  dll_t * restrict out = calloc(1, sizeof(*out));
-
-  return out;
-}
-
-__dll_inline dll_obj_t * dll_new_obj(void * restrict data,
-                                     size_t                       size,
-                                     dll_callback_destructor_fn_t destructor) {
+/**
+ * \b Sets a \p reclaimer for the list \p dll , so #dll_clear , #dll_free , #dll_delete and
+ * all the functions based on them hand list-objects over to \p reclaimer instead of
+ * calling their \c destructor and freeing them.
+ *
+ * \note #dll_clear and #dll_free hand over the whole list in O(1). Destructors run and
+ * list-objects are freed later by #dll_reclaim_step , which may be called from a
+ * background thread.
+ *
+ * \attention \c destructor of every handed over list-object runs on the thread that
+ * calls #dll_reclaim_step , so it must not depend on the list or the calling thread.
+ *
+ * \param dll list.
+ * \param reclaimer reclaimer, or \c NULL to free list-objects inline again.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_set_reclaimer(dll_t * restrict dll,
+                                    dll_reclaimer_t * restrict reclaimer);
+
+/**
+ * \b Frees up to \p budget list-objects handed over to the \p reclaimer , calling their
+ * \c destructor .
+ *
+ * \param reclaimer reclaimer.
+ * \param budget maximum count of list-objects to free, or 0 to free all of them.
+ *
+ * \return count of freed list-objects.
+ */
+__dll_inline size_t dll_reclaim_step(dll_reclaimer_t * restrict reclaimer, size_t budget);
+
+/**
+ * \b Frees all the list-objects handed over to the \p reclaimer and the reclaimer itself.
+ *
+ * \attention No list may still use \p reclaimer after this call.
+ *
+ * \param reclaimer reclaimer.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_reclaimer_free(dll_reclaimer_t * restrict * restrict reclaimer);
+
+/**
+ * \b Relocates all the list-objects of \p dll into contiguous storage blocks in the
+ * order of the list, so traversal walks memory sequentially.
+ *
+ * \note Equals to #dll_compact_step with zero \p budget .
+ *
+ * \attention Every list-object of \p dll gets a new address, all pointers to list-objects
+ * of \p dll become invalid. Use \p fn to update pointers you keep. Data of list-objects
+ * is not moved.
+ *
+ * \param dll list.
+ * \param fn callback-function called for each relocated list-object, may be \c NULL .
+ * \param any any data to be passed to \p fn .
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_COMPACT
+ */
+__dll_inline bool
+    dll_compact(dll_t * restrict dll, dll_callback_relocate_fn_t fn, void * restrict any);
+
+/**
+ * \b Relocates up to \p budget list-objects of \p dll into contiguous storage blocks,
+ * continuing a compaction pass started by a previous call.
+ *
+ * \note A pass goes through the list in its order. List-objects pushed or inserted
+ * before the position the pass has reached are not relocated until the next pass, and
+ * #dll_clear or #dll_splice on \p dll stop the running pass.
+ *
+ * \attention Every relocated list-object gets a new address, so pointers to it become
+ * invalid. Use \p fn to update pointers you keep.
+ *
+ * \param dll list.
+ * \param budget maximum count of list-objects to relocate, or 0 to finish the pass.
+ * \param fn callback-function called for each relocated list-object, may be \c NULL .
+ * \param any any data to be passed to \p fn .
+ *
+ * \return \c true if the pass is finished and the whole list is compacted, \c false
+ * if list-objects are left for next calls, allocation of a storage block failed or
+ * without #LIBDLL_COMPACT
+ */
+__dll_inline bool dll_compact_step(dll_t * restrict dll,
+                                   size_t budget,
+                                   dll_callback_relocate_fn_t fn,
+                                   void * restrict any);
+
+/**
+ * \b Takes an O(1) read-only snapshot of \p dll . The snapshot shares list-objects with
+ * \p dll until \p dll is modified. The first modification copies list-objects, but not
+ * their data, to the snapshot in storage blocks, so an untouched list is never copied.
+ *
+ * \attention The first modification after a snapshot is O(n), as it copies all the
+ * list-objects at once. Later ones are not slowed down until the next snapshot. The copy
+ * can't be limited to the storage blocks a modification touches, as list-objects are
+ * linked one by one and not by blocks, so the copy is relinked as a whole anyway.
+ *
+ * \attention Snapshots aren't synchronized with the list: readers of a snapshot and the
+ * writer of its list must run on the same thread, or be serialized by the caller.
+ *
+ * \note Snapshots taken while \p dll isn't modified in between are the same snapshot,
+ * freed after the last of them.
+ *
+ * \note If the list-objects can't be copied, the modifying call fails as it does when
+ * out of memory, leaving \p dll and the snapshot untouched.
+ *
+ * \note List-objects destroyed by #dll_delete , #dll_clear and functions built on them
+ * while a snapshot is alive keep their data until the snapshot is freed. Data of
+ * list-objects freed by #dll_free_obj after #dll_unlink or #dll_pop_front , and data
+ * replaced by #dll_iterator_set_data , must outlive the snapshot.
+ *
+ * \attention Modifying data itself, not through #dll_iterator_set_data , is visible
+ * through the snapshot.
+ *
+ * \param dll list.
+ *
+ * \return snapshot, \c NULL otherwise
+ */
+__dll_inline dll_snapshot_t * dll_snapshot(dll_t * restrict dll);
+
+/**
+ * \b Get the count of list-objects in the snapshot.
+ *
+ * \param snap snapshot.
+ *
+ * \return count of list-objects.
+ */
+__dll_inline size_t dll_snapshot_size(const dll_snapshot_t * restrict snap);
+
+/**
+ * \b Calls \p fn for each list-object data of the snapshot, as #dll_foreach does.
+ * \p fn may modify the list the snapshot was taken of.
+ *
+ * \param snap snapshot.
+ * \param fn callback-function.
+ * \param any any data to be passed to \p fn .
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_snapshot_foreach(const dll_snapshot_t * restrict snap,
+                                       dll_callback_fn_t fn,
+                                       void * restrict any);
+
+/**
+ * \b Creates an iterator over the snapshot, pointing to its first list-object. The list
+ * may be modified between steps of the iterator.
+ *
+ * \param snap snapshot.
+ *
+ * \return iterator.
+ */
+__dll_inline dll_snapshot_iterator_t
+    dll_snapshot_iterator(const dll_snapshot_t * restrict snap);
+
+/**
+ * \b Moves the snapshot iterator to the next list-object.
+ *
+ * \param it snapshot iterator.
+ *
+ * \return true while not meets the end of snapshot.
+ */
+__dll_inline bool dll_snapshot_next(dll_snapshot_iterator_t * restrict it);
+
+/**
+ * \b Get the data of the list-object the snapshot iterator points to.
+ *
+ * \param it snapshot iterator.
+ *
+ * \return data, \c NULL at the end of snapshot.
+ */
+__dll_inline void * dll_snapshot_iterator_get_data(dll_snapshot_iterator_t * restrict it);
+
+/**
+ * \b Free the snapshot, after the last #dll_snapshot call which returned it.
+ *
+ * \param snap snapshot.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_snapshot_free(dll_snapshot_t * restrict * restrict snap);
+
+/**
+ * \b Prints operation counters of \p dll to \p out in one line of \c name=value pairs.
+ *
+ * \note Counters are kept only if #LIBDLL_STATS is defined.
+ *
+ * \param dll list.
+ * \param out output stream.
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_STATS
+ */
+__dll_inline bool dll_stats_dump(const dll_t * restrict dll, FILE * restrict out);
+
+/**
+ * \b Zeroes operation counters of \p dll . The maximum length starts over from the
+ * current length.
+ *
+ * \param dll list.
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_STATS
+ */
+__dll_inline bool dll_stats_reset(dll_t * restrict dll);
+
+/**
+ * \b Reports the memory footprint of \p dll in O(1), from counters the list keeps
+ * up to date on each insertion and removal.
+ *
+ * \note Counters are kept only if #LIBDLL_MEMORY is defined. Changes of \c size of
+ * list-objects linked to a list aren't seen, as well as allocator overhead of \c data
+ * and memory held by snapshots of the list. Storage blocks and allocator overhead are
+ * reported as upper bounds, so a sum of reports of several lists may count a block more
+ * than once.
+ *
+ * \param dll list.
+ * \param stats receives the footprint.
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_MEMORY
+ */
+__dll_inline bool
+    dll_memory_usage(const dll_t * restrict dll, dll_memory_t * restrict stats);
+
+/**
+ * \b Gets the fingerprint of \p dll : an order-sensitive hash of \c size and \c size
+ * bytes of \c data of its list-objects. Equal lists by #LIBDLL_CMP_BYTES have equal
+ * fingerprints, so do a list and its reverse.
+ *
+ * \note The fingerprint is kept up to date in O(1) by insertions and removals: a linked
+ * list-object hashes its own \c data once and keeps the hash, its neighbours' kept
+ * hashes are reused. Sorting and splicing leave it to be recomputed by the next call,
+ * which hashes \c data of all the list-objects again.
+ *
+ * \attention After modifying \c data of list-objects in place, not through
+ * #dll_iterator_set_data , call #dll_fingerprint_invalidate .
+ *
+ * \param dll list.
+ * \param out receives the fingerprint.
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_FINGERPRINT
+ */
+__dll_inline bool dll_fingerprint(dll_t * restrict dll, uint64_t * restrict out);
+
+/**
+ * \b Makes the next #dll_fingerprint call recompute the fingerprint of \p dll , after
+ * \c data of its list-objects was modified in place.
+ *
+ * \param dll list.
+ *
+ * \return \c true on success, \c false otherwise or without #LIBDLL_FINGERPRINT
+ */
+__dll_inline bool dll_fingerprint_invalidate(dll_t * restrict dll);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+__dll_inline dll_t * dll_new(void) {
+  dll_t * restrict out = (dll_t *)calloc(1, sizeof(*out));
+
+  return out;
+}
+
+__dll_inline dll_obj_t * dll_new_obj(void * restrict data,
+                                     size_t                       size,
+                                     dll_callback_destructor_fn_t destructor) {
   dll_obj_t * restrict out = NULL;
 
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == (out = calloc(1, sizeof(*out))))) {
+  if (__dll_unlikely(NULL == (out = (dll_obj_t *)calloc(1, sizeof(*out))))) {
     return NULL;
   }
 #else
-  out = calloc(1, sizeof(*out));
+  out = (dll_obj_t *)calloc(1, sizeof(*out));
 #endif /* LIBDLL_UNSAFE_USAGE */
 
   out->data       = data;
@@ -706,871 +1651,3133 @@ __dll_inline dll_obj_t * dll_new_obj(void * restrict data,
   return out;
 }
 
-__dll_inline dll_obj_t * dll_push_front(dll_t * restrict dll, dll_obj_t * restrict obj) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == obj)) {
-    return NULL;
+/** A count of list-objects fitting into one storage block after its header. */
+#define __DLLI_BLOCK_OBJS ((LIBDLL_BLOCK_SIZE - sizeof(dll_block_t)) / sizeof(dll_obj_t))
+
+/** A count of storage block addresses one leaf of #__dlli_block_map covers. */
+#define __DLLI_BLOCK_MAP_LEAF (1UL << 16)
+
+/** A count of leaves of #__dlli_block_map covering the 48-bit address space. */
+#define __DLLI_BLOCK_MAP_LEAVES                                                          \
+  ((1ULL << 48) / LIBDLL_BLOCK_SIZE / __DLLI_BLOCK_MAP_LEAF)
+
+/**
+ * A map of alive storage blocks with one bit per #LIBDLL_BLOCK_SIZE bytes of address
+ * space, in leaves allocated on first use and never freed. List-objects don't record
+ * where they live, so it tells block slots from list-objects allocated on their own.
+ *
+ * \note It's weak, so all translation units including this header share one map.
+ */
+__attribute__((weak)) uint64_t * __dlli_block_map[__DLLI_BLOCK_MAP_LEAVES];
+
+/**
+ * \b Marks the storage block at \p block as alive or not in #__dlli_block_map .
+ *
+ * \param block storage block address.
+ * \param alive \c true for an allocated block, \c false for a block about to be freed.
+ *
+ * \return \c false if the map leaf couldn't be allocated or \p block lies beyond the
+ * map, then \p block must not be used.
+ */
+__dll_inline bool __dlli_block_mark(const dll_block_t * restrict block, bool alive) {
+  const uintptr_t key  = (uintptr_t)block / LIBDLL_BLOCK_SIZE;
+  const uintptr_t leaf = key / __DLLI_BLOCK_MAP_LEAF;
+  const uint64_t  bit  = 1ULL << (key % 64);
+
+  if (__dll_unlikely(__DLLI_BLOCK_MAP_LEAVES <= leaf)) {
+    return false;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
 
-  obj->next = NULL;
-  obj->prev = NULL;
+  uint64_t * bits = __atomic_load_n(&__dlli_block_map[leaf], __ATOMIC_ACQUIRE);
 
-  ++dll->objs_count;
-  if (NULL == dll->head) {
-    dll->head = dll->tail = obj;
+  if (NULL == bits) {
+    uint64_t * expected = NULL;
+
+    if (__dll_unlikely(NULL == (bits = (uint64_t *)calloc(__DLLI_BLOCK_MAP_LEAF / 64,
+                                                           sizeof(*bits))))) {
+      return false;
+    }
+    if (!__atomic_compare_exchange_n(&__dlli_block_map[leaf],
+                                     &expected,
+                                     bits,
+                                     false,
+                                     __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE)) {
+      free(bits);
+      bits = expected;
+    }
+  }
+
+  uint64_t * restrict word = &bits[key % __DLLI_BLOCK_MAP_LEAF / 64];
+  if (alive) {
+    __atomic_fetch_or(word, bit, __ATOMIC_RELAXED);
   } else {
-    dll->head->prev = obj;
-    obj->next       = dll->head;
-    dll->head       = obj;
+    __atomic_fetch_and(word, ~bit, __ATOMIC_RELAXED);
   }
-  return obj;
+
+  return true;
 }
 
 /**
- * \b Pushes a provided \p obj list-object to the end of given \p dll list.
+ * \b Checks if list-object \p obj lives in a storage block.
  *
- * \param dll destination list.
- * \param obj list-object.
+ * \param obj a list-object.
  *
- * \return \p obj on success, \c NULL otherwise
+ * \return \c true for a storage block slot, \c false for a list-object allocated on its
+ * own.
  */
-__dll_inline dll_obj_t * dll_push_back(dll_t * restrict dll, dll_obj_t * restrict obj) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == obj)) {
-    return NULL;
+__dll_inline bool __dlli_in_block(const dll_obj_t * restrict obj) {
+  const uintptr_t key  = (uintptr_t)obj / LIBDLL_BLOCK_SIZE;
+  const uintptr_t leaf = key / __DLLI_BLOCK_MAP_LEAF;
+
+  if (__dll_unlikely(__DLLI_BLOCK_MAP_LEAVES <= leaf)) {
+    return false;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
 
-  obj->next = NULL;
-  obj->prev = NULL;
+  const uint64_t * bits = __atomic_load_n(&__dlli_block_map[leaf], __ATOMIC_ACQUIRE);
+  if (NULL == bits) {
+    return false;
+  }
 
-  ++dll->objs_count;
-  if (NULL == dll->head) {
-    dll->head = dll->tail = obj;
-  } else {
-    dll->tail->next = obj;
-    obj->prev       = dll->tail;
-    dll->tail       = obj;
+  const uint64_t word =
+      __atomic_load_n(&bits[key % __DLLI_BLOCK_MAP_LEAF / 64], __ATOMIC_RELAXED);
+
+  return (word >> (key % 64)) & 1;
+}
+
+/**
+ * \b Get the storage block in which list-object \p obj lives.
+ *
+ * \param obj a list-object living in a storage block, see #__dlli_in_block .
+ *
+ * \return storage block header.
+ */
+__dll_inline dll_block_t * __dlli_block_of(const dll_obj_t * restrict obj) {
+  return (dll_block_t *)((uintptr_t)obj & ~((uintptr_t)LIBDLL_BLOCK_SIZE - 1));
+}
+
+/**
+ * \b Allocates a new storage block, referenced once by its creator.
+ *
+ * \return a new storage block, \c NULL otherwise
+ */
+__dll_inline dll_block_t * __dlli_block_new(void) {
+  dll_block_t * restrict block =
+      (dll_block_t *)aligned_alloc(LIBDLL_BLOCK_SIZE, LIBDLL_BLOCK_SIZE);
+
+  if (block && __dll_unlikely(!__dlli_block_mark(block, true))) {
+    free(block);
+    block = NULL;
   }
+  if (block) {
+    block->__live       = 1;
+    block->__used       = 0;
+    block->__owner      = NULL;
+    block->__owner_objs = 0;
+  }
+
+  return block;
+}
+
+/**
+ * \b Frees \p block regardless of its references.
+ *
+ * \param block storage block.
+ */
+__dll_inline void __dlli_block_free(dll_block_t * restrict block) {
+  __dlli_block_mark(block, false);
+  free(block);
+}
+
+/**
+ * \b Takes the next free slot of \p block for a list-object.
+ *
+ * \param block storage block with free slots.
+ *
+ * \return uninitialized list-object inside of \p block .
+ */
+__dll_inline dll_obj_t * __dlli_block_take(dll_block_t * restrict block) {
+  dll_obj_t * restrict obj = (dll_obj_t *)(block + 1) + block->__used++;
+
+  __atomic_add_fetch(&block->__live, 1, __ATOMIC_RELAXED);
   return obj;
 }
 
-__dll_inline dll_obj_t * dll_emplace_front(dll_t * restrict dll,
-                                           void * restrict data,
-                                           size_t                       size,
-                                           dll_callback_destructor_fn_t destructor) {
-  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
-  dll_obj_t * restrict __ret   = dll_push_front(dll, new_obj);
+/**
+ * \b Drops \p count references to \p block and frees it after the last one.
+ *
+ * \param block storage block.
+ * \param count count of released list-objects.
+ */
+__dll_inline void __dlli_block_release(dll_block_t * restrict block, size_t count) {
+  if (0 == __atomic_sub_fetch(&block->__live, count, __ATOMIC_ACQ_REL)) {
+    __dlli_block_free(block);
+  }
+}
+
+/**
+ * \b Frees the memory of list-object \p obj itself, without touching its \c data .
+ *
+ * \param obj a list-object.
+ */
+__dll_inline void __dlli_release_obj(dll_obj_t * restrict obj) {
+  if (__dlli_in_block(obj)) {
+    __dlli_block_release(__dlli_block_of(obj), 1);
+  } else {
+    free(obj);
+  }
+}
+
+/**
+ * \b Copies list-objects shared by the snapshot \p snap with its list into storage
+ * blocks owned by \p snap . Data of list-objects isn't copied.
+ *
+ * \note All the storage blocks are allocated before anything is copied, so if any of
+ * them can't be, \p snap stays untouched and keeps sharing list-objects.
+ *
+ * \param snap snapshot sharing list-objects.
+ *
+ * \return \c true if \p snap doesn't share list-objects anymore.
+ */
+__dll_inline bool __dlli_snapshot_copy(dll_snapshot_t * restrict snap) {
+  const size_t segments = (snap->objs_count + __DLLI_BLOCK_OBJS - 1) / __DLLI_BLOCK_OBJS;
+  dll_block_t ** restrict blocks =
+      (dll_block_t **)calloc(segments + 1, sizeof(dll_block_t *));
+  dll_obj_t * iobj = snap->head;
+  dll_obj_t * prev = NULL;
+  size_t      i    = 0;
+
+  for (; blocks && segments > i; ++i) {
+    if (NULL == (blocks[i] = __dlli_block_new())) {
+      while (i) {
+        __dlli_block_free(blocks[--i]);
+      }
+      free(blocks);
+      blocks = NULL;
+    }
+  }
+  if (NULL == blocks) {
+    return false;
+  }
+
+  snap->__shared   = false;
+  snap->__segments = blocks;
+  snap->head       = NULL;
+
+  for (i = 0; snap->objs_count > i; ++i) {
+    dll_obj_t * restrict obj = __dlli_block_take(blocks[i / __DLLI_BLOCK_OBJS]);
+
+    *obj      = *iobj;
+    obj->prev = prev;
+    obj->next = NULL;
+
+    iobj = snap->__reversed ? iobj->prev : iobj->next;
+    if (prev) {
+      prev->next = obj;
+    } else {
+      snap->head = obj;
+    }
+    prev = obj;
+  }
+
+  snap->tail       = prev;
+  snap->__reversed = false;
+  return true;
+}
+
+/**
+ * \b Keeps the newest snapshot of \p dll intact before \p dll is modified, copying
+ * the list-objects it shares.
+ *
+ * \param dll list.
+ *
+ * \return \c false if the list-objects couldn't be copied, then \p dll must not be
+ * modified.
+ */
+__dll_inline bool __dlli_cow(dll_t * restrict dll) {
+  if (__dll_unlikely(dll->__snapshot && dll->__snapshot->__shared)) {
+    return __dlli_snapshot_copy(dll->__snapshot);
+  }
+  return true;
+}
+
+/**
+ * \b Hands a chain of list-objects from \p first to \p last linked through \c next
+ * over to the snapshot \p snap , which may still reference their data. The chain is
+ * destroyed when no snapshot references it anymore.
+ *
+ * \param snap newest alive snapshot of the list the chain was removed from.
+ * \param first first list-object of the chain.
+ * \param last last list-object of the chain.
+ */
+__dll_inline void __dlli_retire(dll_snapshot_t * restrict snap,
+                                dll_obj_t * first,
+                                dll_obj_t * last) {
+  last->next      = snap->__retired;
+  snap->__retired = first;
+}
+
+/**
+ * \b Accounts list-object \p obj linked to \p dll for #dll_memory_usage .
+ *
+ * \param dll list.
+ * \param obj list-object.
+ */
+__dll_inline void __dlli_mem_link(dll_t * restrict dll, const dll_obj_t * restrict obj) {
+#ifdef LIBDLL_MEMORY
+  dll->__data_bytes += obj->size;
+  if (__dlli_in_block(obj)) {
+    dll_block_t * restrict block = __dlli_block_of(obj);
+    void * owner                 = __atomic_load_n(&block->__owner, __ATOMIC_ACQUIRE);
+
+    ++dll->__block_objs;
+    // the first list linking a list-object of a free block accounts the block
+    if (NULL == owner &&
+        __atomic_compare_exchange_n(&block->__owner, &owner, dll, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      owner = dll;
+      ++dll->__blocks;
+    }
+    if (owner == dll) {
+      ++block->__owner_objs;
+    } else {
+      ++dll->__foreign_objs;
+    }
+  }
+#else
+  (void)dll;
+  (void)obj;
+#endif /* LIBDLL_MEMORY */
+}
+
+/**
+ * \b Accounts list-object \p obj unlinked from \p dll for #dll_memory_usage .
+ *
+ * \param dll list.
+ * \param obj list-object.
+ */
+__dll_inline void __dlli_mem_unlink(dll_t * restrict dll,
+                                    const dll_obj_t * restrict obj) {
+#ifdef LIBDLL_MEMORY
+  dll->__data_bytes -= obj->size;
+  if (__dlli_in_block(obj)) {
+    dll_block_t * restrict block = __dlli_block_of(obj);
+
+    --dll->__block_objs;
+    if (__atomic_load_n(&block->__owner, __ATOMIC_ACQUIRE) != dll) {
+      --dll->__foreign_objs;
+    } else if (0 == --block->__owner_objs) {
+      --dll->__blocks;
+      __atomic_store_n(&block->__owner, NULL, __ATOMIC_RELEASE);
+    }
+  }
+#else
+  (void)dll;
+  (void)obj;
+#endif /* LIBDLL_MEMORY */
+}
+
+#ifdef LIBDLL_FINGERPRINT
+/**
+ * \b Mixes bits of \p h , the finalizer of MurmurHash3.
+ *
+ * \param h value.
+ *
+ * \return mixed value.
+ */
+__dll_inline uint64_t __dlli_fp_mix(uint64_t h) {
+  h = (h ^ (h >> 33)) * 0xFF51AFD7ED558CCDULL;
+  h = (h ^ (h >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+  return h ^ (h >> 33);
+}
+
+/**
+ * \b Hashes \c size and \c size bytes of \c data of list-object \p obj .
+ *
+ * \param obj list-object, or \c NULL for the ends of a list.
+ *
+ * \return hash, 0 for \c NULL .
+ */
+__dll_inline uint64_t __dlli_fp_hash(const dll_obj_t * restrict obj) {
+  if (NULL == obj) {
+    return 0;
+  }
+
+  const unsigned char * restrict bytes = (const unsigned char *)obj->data;
+  const size_t                   size  = bytes ? obj->size : 0;
+  uint64_t                       h     = 0x9E3779B97F4A7C15ULL ^ obj->size;
+  uint64_t                       word  = 0;
+  size_t                         i     = 0;
+
+  for (; size >= i + sizeof(word); i += sizeof(word)) {
+    memcpy(&word, bytes + i, sizeof(word));
+    h = (h ^ __dlli_fp_mix(word)) * 0x100000001B3ULL;
+  }
+  if (size > i) {
+    word = 0;
+    memcpy(&word, bytes + i, size - i);
+    h = (h ^ __dlli_fp_mix(word)) * 0x100000001B3ULL;
+  }
+
+  return __dlli_fp_mix(h);
+}
+
+/**
+ * \b Hashes a link between neighbours hashed as \p a and \p b , the same in both
+ * directions.
+ *
+ * \param a hash of a list-object.
+ * \param b hash of its neighbour.
+ *
+ * \return hash of the link.
+ */
+__dll_inline uint64_t __dlli_fp_link_hash(uint64_t a, uint64_t b) {
+  return a < b ? __dlli_fp_mix(a * 0x9E3779B97F4A7C15ULL + b)
+               : __dlli_fp_mix(b * 0x9E3779B97F4A7C15ULL + a);
+}
+
+/**
+ * \b Gets the hash list-object \p obj kept when it was linked.
+ *
+ * \param obj list-object, or \c NULL for the ends of a list.
+ *
+ * \return kept hash, 0 for \c NULL .
+ */
+__dll_inline uint64_t __dlli_fp_kept(const dll_obj_t * restrict obj) {
+  return obj ? obj->__fp_hash : 0;
+}
+
+/**
+ * \b Computes the change of the fingerprint of \p dll made by linking \p obj between
+ * its neighbours: the links to them replace the one between them. Only kept hashes are
+ * used, no \c data is read.
+ *
+ * \param dll list.
+ * \param obj list-object linked to \p dll .
+ *
+ * \return fingerprint change.
+ */
+__dll_inline uint64_t __dlli_fp_delta(const dll_t * restrict dll,
+                                      const dll_obj_t * restrict obj) {
+  const uint64_t prev = __dlli_fp_kept(__dlli_prev(dll, obj));
+  const uint64_t next = __dlli_fp_kept(__dlli_next(dll, obj));
+  const uint64_t self = obj->__fp_hash;
+
+  return __dlli_fp_link_hash(prev, self) + __dlli_fp_link_hash(self, next) -
+         __dlli_fp_link_hash(prev, next);
+}
+#endif /* LIBDLL_FINGERPRINT */
+
+/**
+ * \b Accounts list-object \p obj just linked to \p dll in its fingerprint, hashing its
+ * \c data and keeping the hash in it. Nothing is done while the fingerprint is stale,
+ * its recomputation hashes all the list-objects again.
+ *
+ * \param dll list.
+ * \param obj list-object.
+ */
+__dll_inline void __dlli_fp_link(dll_t * restrict dll, dll_obj_t * restrict obj) {
+#ifdef LIBDLL_FINGERPRINT
+  if (!dll->__fp_stale) {
+    obj->__fp_hash = __dlli_fp_hash(obj);
+    dll->__fingerprint += __dlli_fp_delta(dll, obj);
+  }
+#else
+  (void)dll;
+  (void)obj;
+#endif /* LIBDLL_FINGERPRINT */
+}
+
+/**
+ * \b Accounts list-object \p obj about to be unlinked from \p dll in its fingerprint.
+ *
+ * \param dll list.
+ * \param obj list-object.
+ */
+__dll_inline void __dlli_fp_unlink(dll_t * restrict dll, const dll_obj_t * restrict obj) {
+#ifdef LIBDLL_FINGERPRINT
+  if (!dll->__fp_stale) {
+    dll->__fingerprint -= __dlli_fp_delta(dll, obj);
+  }
+#else
+  (void)dll;
+  (void)obj;
+#endif /* LIBDLL_FINGERPRINT */
+}
+
+#ifdef LIBDLL_SORTED
+/**
+ * \b Computes the height of the overlay tower for \p obj from its address: about one in
+ * four list-objects gets a tower, and every next level is four times rarer. While the
+ * overlay of a list is built, every list-object of it with a non-zero height has its
+ * tower there.
+ *
+ * \param obj list-object.
+ *
+ * \return tower height, 0 if \p obj gets no tower.
+ */
+__dll_inline size_t __dlli_skip_height(const dll_obj_t * restrict obj) {
+  uint64_t hash   = (uint64_t)(uintptr_t)obj;
+  size_t   height = 0;
+
+  hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+  hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+
+  for (; LIBDLL_SKIP_LEVELS > height && 0 == (hash >> 62); hash <<= 2) {
+    ++height;
+  }
+
+  return height;
+}
+
+/**
+ * \b Creates a new overlay tower of \p levels levels for \p obj in the overlay of
+ * \p dll .
+ *
+ * \param dll list.
+ * \param obj list-object.
+ * \param levels tower height.
+ *
+ * \return allocated tower, \c NULL otherwise.
+ */
+__dll_inline dll_skip_t *
+    __dlli_skip_tower_new(dll_t * restrict dll, dll_obj_t * restrict obj, size_t levels) {
+  const size_t          bytes = sizeof(dll_skip_t) + levels * sizeof(dll_skip_t *);
+  dll_skip_t * restrict out   = (dll_skip_t *)calloc(1, bytes);
+
+  if (__dll_likely(NULL != out)) {
+    out->__obj    = obj;
+    out->__levels = levels;
+    dll->__skip_bytes += bytes;
+  }
+  return out;
+}
+
+/**
+ * \b Frees the skip-list overlay of \p dll , if any.
+ *
+ * \param dll list.
+ */
+__dll_inline void __dlli_skip_drop(dll_t * restrict dll) {
+  for (dll_skip_t * tower = dll->__skip; tower;) {
+    dll_skip_t * save = tower->__next[0];
+
+    free(tower);
+    tower = save;
+  }
+
+  dll->__skip       = NULL;
+  dll->__skip_bytes = 0;
+}
+
+/**
+ * \b Returns the skip-list overlay of the sorted \p dll , building it first if needed.
+ *
+ * \param dll list.
+ *
+ * \return the head tower of the overlay, \c NULL if \p dll isn't sorted or on failure.
+ */
+__dll_inline dll_skip_t * __dlli_skip_get(dll_t * restrict dll) {
+  if (dll->__skip || NULL == dll->__sorted_cmp) {
+    return dll->__skip;
+  }
+
+  dll_skip_t * last[LIBDLL_SKIP_LEVELS];
+
+  dll->__skip = __dlli_skip_tower_new(dll, NULL, LIBDLL_SKIP_LEVELS);
+  if (__dll_unlikely(NULL == dll->__skip)) {
+    return NULL;
+  }
+  for (size_t l = 0; LIBDLL_SKIP_LEVELS > l; ++l) {
+    last[l] = dll->__skip;
+  }
+
+  for (dll_obj_t * iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    const size_t height = __dlli_skip_height(iobj);
+
+    if (0 == height) {
+      continue;
+    }
+
+    dll_skip_t * tower = __dlli_skip_tower_new(dll, iobj, height);
+    if (__dll_unlikely(NULL == tower)) {
+      __dlli_skip_drop(dll);
+      return NULL;
+    }
+
+    for (size_t l = 0; height > l; ++l) {
+      last[l]->__next[l] = tower;
+      last[l]            = tower;
+    }
+  }
+
+  return dll->__skip;
+}
+
+/**
+ * \b Searches the sorted \p dll for the first list-object which is greater than \p key ,
+ * or not less than it if \p upper is \c false .
+ *
+ * \param dll list.
+ * \param key data to be passed as the second argument of the list comparator.
+ * \param upper search for the upper bound instead of the lower one.
+ * \param update receives the last tower before the found list-object on each level,
+ * may be \c NULL .
+ *
+ * \return found list-object, \c NULL if there is no such.
+ */
+__dll_inline dll_obj_t * __dlli_skip_seek(dll_t * restrict dll,
+                                          void *           key,
+                                          bool             upper,
+                                          dll_skip_t **    update) {
+  dll_callback_ext_fn_t fn_cmp = dll->__sorted_cmp;
+  void *                any    = dll->__sorted_any;
+  const ssize_t         bound  = upper ? 0 : -1;
+  dll_skip_t *          x      = __dlli_skip_get(dll);
+
+  if (x) {
+    for (size_t l = LIBDLL_SKIP_LEVELS; l--;) {
+      while (x->__next[l] && bound >= fn_cmp(x->__next[l]->__obj->data, key, any, ~0UL)) {
+        x = x->__next[l];
+      }
+      if (update) {
+        update[l] = x;
+      }
+    }
+  }
+
+  dll_obj_t * iobj = x && x->__obj ? __dlli_next(dll, x->__obj) : dll->head;
+  while (iobj && bound >= fn_cmp(iobj->data, key, any, ~0UL)) {
+    iobj = __dlli_next(dll, iobj);
+  }
+
+  return iobj;
+}
+
+/**
+ * \b Removes the overlay tower of \p obj from the sorted \p dll .
+ *
+ * \param dll list.
+ * \param obj list-object, nothing is done if it has no tower.
+ */
+__dll_inline void __dlli_skip_remove(dll_t * restrict dll, dll_obj_t * restrict obj) {
+  dll_callback_ext_fn_t fn_cmp = dll->__sorted_cmp;
+  void *                any    = dll->__sorted_any;
+  dll_skip_t *          x      = dll->__skip;
+  dll_skip_t *          tower  = NULL;
+
+  if (NULL == x || 0 == __dlli_skip_height(obj)) {
+    return;
+  }
+
+  for (size_t l = LIBDLL_SKIP_LEVELS; l--;) {
+    while (x->__next[l] && 0 > fn_cmp(x->__next[l]->__obj->data, obj->data, any, ~0UL)) {
+      x = x->__next[l];
+    }
+
+    dll_skip_t * y = x;
+    while (y->__next[l] && obj != y->__next[l]->__obj &&
+           0 == fn_cmp(y->__next[l]->__obj->data, obj->data, any, ~0UL)) {
+      y = y->__next[l];
+    }
+
+    if (y->__next[l] && obj == y->__next[l]->__obj) {
+      tower        = y->__next[l];
+      y->__next[l] = tower->__next[l];
+    } else if (0 == l) {
+      // the list isn't sorted anymore, so the overlay is stale anyway
+      __dlli_skip_drop(dll);
+      return;
+    }
+  }
+
+  dll->__skip_bytes -= sizeof(*tower) + tower->__levels * sizeof(*tower->__next);
+  free(tower);
+}
+#else
+/**
+ * \b Frees the skip-list overlay of \p _dll , there is none without #LIBDLL_SORTED .
+ */
+#  define __dlli_skip_drop(_dll) ((void)0)
+#endif /* LIBDLL_SORTED */
+
+__dll_inline dll_obj_t * dll_push_front(dll_t * restrict dll, dll_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return NULL;
+  }
+
+  __dlli_probe_arg(push_front_entry, dll, obj);
+  obj->next = NULL;
+  obj->prev = NULL;
+  __dlli_skip_drop(dll);
+
+  ++dll->objs_count;
+  __dlli_mem_link(dll, obj);
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat_len(dll);
+  if (NULL == dll->head) {
+    dll->head = dll->tail = obj;
+  } else {
+    __dlli_prev(dll, dll->head) = obj;
+    __dlli_next(dll, obj)       = dll->head;
+    dll->head                   = obj;
+  }
+  __dlli_fp_link(dll, obj);
+  __dlli_probe_arg(push_front_return, dll, obj);
+  return obj;
+}
+
+/**
+ * \b Pushes a provided \p obj list-object to the end of given \p dll list.
+ *
+ * \param dll destination list.
+ * \param obj list-object.
+ *
+ * \return \p obj on success, \c NULL otherwise
+ */
+__dll_inline dll_obj_t * dll_push_back(dll_t * restrict dll, dll_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return NULL;
+  }
+
+  __dlli_probe_arg(push_back_entry, dll, obj);
+  obj->next = NULL;
+  obj->prev = NULL;
+  __dlli_skip_drop(dll);
+
+  ++dll->objs_count;
+  __dlli_mem_link(dll, obj);
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat_len(dll);
+  if (NULL == dll->head) {
+    dll->head = dll->tail = obj;
+  } else {
+    __dlli_next(dll, dll->tail) = obj;
+    __dlli_prev(dll, obj)       = dll->tail;
+    dll->tail                   = obj;
+  }
+  __dlli_fp_link(dll, obj);
+  __dlli_probe_arg(push_back_return, dll, obj);
+  return obj;
+}
+
+__dll_inline dll_obj_t * dll_emplace_front(dll_t * restrict dll,
+                                           void * restrict data,
+                                           size_t                       size,
+                                           dll_callback_destructor_fn_t destructor) {
+  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
+  dll_obj_t * restrict __ret   = dll_push_front(dll, new_obj);
+
+  if (__ret) {
+    __dlli_stat(dll, allocs, 1);
+  } else {
+    free(new_obj);
+  }
+  return __ret;
+}
+
+__dll_inline dll_obj_t * dll_emplace_back(dll_t * restrict dll,
+                                          void * restrict data,
+                                          size_t                       size,
+                                          dll_callback_destructor_fn_t destructor) {
+  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
+  dll_obj_t * restrict __ret   = dll_push_back(dll, new_obj);
+
+  if (__ret) {
+    __dlli_stat(dll, allocs, 1);
+  } else {
+    free(new_obj);
+  }
+  return __ret;
+}
+
+__dll_inline dll_obj_t * dll_pop_front(dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (NULL == dll->head) {
+    return NULL;
+  }
+
+  __dlli_probe(pop_front_entry, dll);
+  dll_obj_t * restrict __ret = dll_unlink(dll, dll->head);
+
+  __dlli_probe_arg(pop_front_return, dll, __ret);
+  return __ret;
+}
+
+__dll_inline dll_obj_t * dll_pop_back(dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (NULL == dll->tail) {
+    return NULL;
+  }
+
+  __dlli_probe(pop_back_entry, dll);
+  dll_obj_t * restrict __ret = dll_unlink(dll, dll->tail);
+
+  __dlli_probe_arg(pop_back_return, dll, __ret);
+  return __ret;
+}
+
+#ifdef LIBDLL_COMPACT
+/**
+ * \b Stops a running #dll_compact_step pass over \p dll .
+ *
+ * \param dll list.
+ */
+__dll_inline void __dlli_compact_finish(dll_t * restrict dll) {
+  if (dll->__compact_block) {
+    __dlli_block_release(dll->__compact_block, 1);
+  }
+
+  dll->__compact_block = NULL;
+  dll->__compact_next  = NULL;
+}
+#else
+/**
+ * \b Stops a running #dll_compact_step pass over \p _dll , there is none without
+ * #LIBDLL_COMPACT .
+ */
+#  define __dlli_compact_finish(_dll) ((void)0)
+#endif /* LIBDLL_COMPACT */
+
+/**
+ * \b Detaches all the list-objects from \p dll in O(1), leaving the list empty. With
+ * #LIBDLL_MEMORY it's O(n) while \p dll accounts storage blocks as its own, which it
+ * gives up.
+ *
+ * \note The caller keeps snapshots of \p dll intact with #__dlli_cow first.
+ *
+ * \param dll list.
+ * \param last receives the last list-object of the detached chain.
+ *
+ * \return first list-object of the detached chain linked through \c next , or \c NULL
+ * if \p dll was empty.
+ */
+__dll_inline dll_obj_t * __dlli_detach(dll_t * restrict dll,
+                                       dll_obj_t * restrict * restrict last) {
+  dll_obj_t * restrict first = dll->__reversed ? dll->tail : dll->head;
+
+  *last = dll->__reversed ? dll->head : dll->tail;
+
+#ifdef LIBDLL_MEMORY
+  for (dll_obj_t * iobj = dll->__blocks ? first : NULL; iobj; iobj = iobj->next) {
+    if (__dlli_in_block(iobj) &&
+        __atomic_load_n(&__dlli_block_of(iobj)->__owner, __ATOMIC_ACQUIRE) == dll) {
+      __dlli_block_of(iobj)->__owner_objs = 0;
+      __atomic_store_n(&__dlli_block_of(iobj)->__owner, NULL, __ATOMIC_RELEASE);
+    }
+  }
+#endif /* LIBDLL_MEMORY */
+  __dlli_skip_drop(dll);
+  dll->head = dll->tail = NULL;
+  dll->objs_count       = 0;
+  dll->__reversed       = false;
+#ifdef LIBDLL_MEMORY
+  dll->__data_bytes   = 0;
+  dll->__block_objs   = 0;
+  dll->__blocks       = 0;
+  dll->__foreign_objs = 0;
+#endif /* LIBDLL_MEMORY */
+#ifdef LIBDLL_FINGERPRINT
+  dll->__fingerprint = 0;
+  dll->__fp_stale    = false;
+#endif /* LIBDLL_FINGERPRINT */
+  __dlli_compact_finish(dll);
+
+  return first;
+}
+
+/**
+ * \b Hands a chain of list-objects from \p first to \p last linked through \c next
+ * over to the \p reclaimer .
+ *
+ * \param reclaimer reclaimer.
+ * \param first first list-object of the chain.
+ * \param last last list-object of the chain.
+ */
+__dll_inline void __dlli_reclaim(dll_reclaimer_t * restrict reclaimer,
+                                 dll_obj_t * first,
+                                 dll_obj_t * last) {
+  dll_obj_t * pending = __atomic_load_n(&reclaimer->__pending, __ATOMIC_RELAXED);
+
+  do {
+    last->next = pending;
+  } while (!__atomic_compare_exchange_n(&reclaimer->__pending,
+                                        &pending,
+                                        first,
+                                        true,
+                                        __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+}
+
+/**
+ * \b Calls a \c destructor of list-object \p obj for its \c data .
+ *
+ * \param obj a list-object.
+ */
+__dll_inline void __dlli_destroy_data(dll_obj_t * restrict obj) {
+  if (obj->destructor) {
+    if (LIBDLL_DESTRUCTOR_DEFAULT == obj->destructor) {
+      free(obj->data);
+    } else {
+      obj->destructor(obj->data);
+    }
+  }
+}
+
+/**
+ * \b Calls a \c destructor of list-object \p obj for its \c data and frees \p obj .
+ *
+ * \param obj a list-object.
+ */
+__dll_inline void __dlli_destroy_obj(dll_obj_t * restrict obj) {
+  __dlli_destroy_data(obj);
+  __dlli_release_obj(obj);
+}
+
+/**
+ * \b Destroys a detached chain of list-objects linked through \c next , starting at
+ * \p iobj , while prefetching the next list-object ahead of each destructor call.
+ *
+ * \note List-objects living in storage blocks are returned to their block in bulk, one
+ * release per run of list-objects from the same block.
+ *
+ * \param iobj first list-object of the chain.
+ */
+__dll_inline void __dlli_free_chain(dll_obj_t * restrict iobj) {
+  dll_block_t * restrict block = NULL;
+  size_t block_objs            = 0;
+
+  while (iobj) {
+    dll_obj_t * restrict save = iobj->next;
+
+    if (save) {
+      __dll_prefetch(save);
+    }
+    __dlli_destroy_data(iobj);
+
+    if (__dlli_in_block(iobj)) {
+      dll_block_t * restrict iblock = __dlli_block_of(iobj);
+
+      if (iblock != block) {
+        if (block) {
+          __dlli_block_release(block, block_objs);
+        }
+        block      = iblock;
+        block_objs = 0;
+      }
+      ++block_objs;
+    } else {
+      free(iobj);
+    }
+
+    iobj = save;
+  }
+
+  if (block) {
+    __dlli_block_release(block, block_objs);
+  }
+}
+
+__dll_inline bool dll_clear(dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return false;
+  }
+
+  __dlli_probe(clear_entry, dll);
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat(dll, frees, dll->objs_count);
+  if (dll->__snapshot || dll->__reclaimer) {
+    dll_obj_t * restrict last  = NULL;
+    dll_obj_t * restrict first = __dlli_detach(dll, &last);
+
+    if (first && dll->__snapshot) {
+      __dlli_retire(dll->__snapshot, first, last);
+    } else if (first) {
+      __dlli_reclaim(dll->__reclaimer, first, last);
+    }
+    __dlli_probe(clear_return, dll);
+    return true;
+  }
+
+  dll_obj_t * restrict last = NULL;
+
+  __dlli_free_chain(__dlli_detach(dll, &last));
+
+  __dlli_probe(clear_return, dll);
+  return true;
+}
+
+__dll_inline dll_obj_t *
+    dll_insert(dll_t * restrict dll, dll_obj_t * restrict obj, size_t pos) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (dll->objs_count < pos) {
+    return NULL;
+  }
+
+  __dlli_probe_arg(insert_entry, dll, pos);
+  if (NULL == dll->head || 0 == pos) {
+    dll_obj_t * restrict __ret = dll_push_front(dll, obj);
+
+    __dlli_probe_arg(insert_return, dll, 0);
+    return __ret;
+  } else {
+    dll_obj_t * restrict iter = dll->head;
+
+    for (size_t i = 0; (pos - 1) > i && iter; ++i) {
+      iter = __dlli_next(dll, iter);
+    }
+    __dlli_stat(dll, steps, pos - 1);
+
+    if (__dll_unlikely(!__dlli_cow(dll))) {
+      __dlli_probe_arg(insert_return, dll, pos - 1);
+      return NULL;
+    }
+    __dlli_skip_drop(dll);
+    __dlli_next(dll, obj) = __dlli_next(dll, iter);
+    __dlli_prev(dll, obj) = iter;
+    if (__dlli_next(dll, iter)) {
+      __dlli_prev(dll, __dlli_next(dll, iter)) = obj;
+    } else {
+      dll->tail = obj;
+    }
+    __dlli_next(dll, iter) = obj;
+
+    ++dll->objs_count;
+    __dlli_mem_link(dll, obj);
+    __dlli_fp_link(dll, obj);
+    __dlli_stat(dll, ops, 1);
+    __dlli_stat_len(dll);
+
+    __dlli_probe_arg(insert_return, dll, pos - 1);
+    return obj;
+  }
+}
+
+__dll_inline dll_obj_t * dll_emplace(dll_t * restrict dll,
+                                     void * restrict data,
+                                     size_t                       size,
+                                     dll_callback_destructor_fn_t destructor,
+                                     size_t                       pos) {
+  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
+  dll_obj_t * restrict __ret   = dll_insert(dll, new_obj, pos);
+
+  if (__ret) {
+    __dlli_stat(dll, allocs, 1);
+  } else {
+    free(new_obj);
+  }
+  return __ret;
+}
+
+__dll_inline dll_obj_t * __dlli_get_obj_at_index(dll_t * restrict dll, size_t pos) {
+  const size_t dll_size    = dll->objs_count;
+  dll_obj_t * restrict obj = NULL;
+
+  if ((dll_size / 2) >= pos) {
+    obj = dll->head;
+    for (size_t i = 0; obj && pos > i; ++i) {
+      obj = __dlli_next(dll, obj);
+    }
+    __dlli_stat(dll, steps, pos);
+  } else {
+    obj = dll->tail;
+    for (size_t i = dll_size ? dll_size - 1 : dll_size; obj && pos < i; --i) {
+      obj = __dlli_prev(dll, obj);
+    }
+    __dlli_stat(dll, steps, pos < dll_size ? dll_size - 1 - pos : 0);
+  }
+
+  return obj;
+}
+
+__dll_inline dll_obj_t * dll_erase(dll_t * restrict dll, size_t start, size_t end) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (0 == dll->objs_count || dll->objs_count < start) {
+    return NULL;
+  }
+
+  dll_obj_t * restrict erasing = __dlli_get_obj_at_index(dll, start);
+  dll_obj_t * restrict save    = NULL;
+  size_t i                     = start ? start - 1 : start;
+
+  do {
+    save = __dlli_next(dll, erasing);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+    if (false == dll_delete(dll, erasing)) {
+      return NULL;
+    }
+#else
+    dll_delete(dll, erasing);
+#endif
+
+    erasing = save;
+  } while (end > i++ && erasing);
+
+  return erasing ? erasing : dll->tail;
+}
+
+/**
+ * \b Prefetches up to #LIBDLL_PREFETCH_DISTANCE list-objects of \p dll after \p iobj .
+ *
+ * \param dll list.
+ * \param iobj list-object from which traversal starts.
+ *
+ * \return the farthest prefetched list-object to be passed to #__dlli_prefetch_step .
+ */
+__dll_inline dll_obj_t * __dlli_prefetch_start(const dll_t * restrict dll,
+                                               dll_obj_t * iobj) {
+#if LIBDLL_PREFETCH_DISTANCE
+  for (size_t i = 0; LIBDLL_PREFETCH_DISTANCE > i && iobj; ++i) {
+    iobj = __dlli_next(dll, iobj);
+    if (iobj) {
+      __dll_prefetch(iobj);
+    }
+  }
+
+  return iobj;
+#else
+  (void)dll;
+  (void)iobj;
+  return NULL;
+#endif /* LIBDLL_PREFETCH_DISTANCE */
+}
+
+/**
+ * \b Moves the prefetching window of a traversal over \p dll one list-object further:
+ * prefetches \c data of \p ahead and the list-object after it.
+ *
+ * \param dll list.
+ * \param ahead the farthest prefetched list-object.
+ *
+ * \return the new farthest prefetched list-object.
+ */
+__dll_inline dll_obj_t * __dlli_prefetch_step(const dll_t * restrict dll,
+                                              dll_obj_t * ahead) {
+#if LIBDLL_PREFETCH_DISTANCE
+  if (NULL == ahead) {
+    return NULL;
+  }
+
+  __dll_prefetch(ahead->data);
+  ahead = __dlli_next(dll, ahead);
+  if (ahead) {
+    __dll_prefetch(ahead);
+  }
+
+  return ahead;
+#else
+  (void)dll;
+  (void)ahead;
+  return NULL;
+#endif /* LIBDLL_PREFETCH_DISTANCE */
+}
+
+__dll_inline bool
+    dll_foreach(const dll_t * restrict dll, dll_callback_fn_t fn, void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * ahead = __dlli_prefetch_start(dll, dll->head);
+  size_t      i     = 0;
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    ahead = __dlli_prefetch_step(dll, ahead);
+    fn(iobj->data, any, i++);
+  }
+  __dlli_stat(dll, steps, i);
+  __dlli_stat(dll, calls, i);
+
+  return true;
+}
+
+__dll_inline dll_iterator_t dll_iterator(dll_t * restrict const dll) {
+  dll_iterator_t it = {
+#ifndef LIBDLL_UNSAFE_USAGE
+      dll ? dll->head : NULL,
+#else
+      dll->head,
+#endif
+      dll,
+      0};
+
+  return it;
+}
+
+__dll_inline bool dll_next(dll_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || (it && NULL == it->__dll))) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  it->__obj = it->__obj ? __dlli_next(it->__dll, it->__obj) : NULL;
+  ++it->__index;
+
+  return !!it->__obj;
+}
+
+__dll_inline bool dll_prev(dll_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || (it && NULL == it->__dll))) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  it->__obj = it->__obj ? __dlli_prev(it->__dll, it->__obj) : NULL;
+  --it->__index;
+
+  return !!it->__obj;
+}
+
+__dll_inline dll_obj_t * dll_iterator_get_obj(const dll_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__obj;
+}
+
+__dll_inline void * dll_iterator_get_data(const dll_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__obj->data;
+}
+
+__dll_inline void * dll_iterator_set_data(const dll_iterator_t * restrict const it,
+                                          void * restrict data,
+                                          dll_callback_destructor_fn_t destructor) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  void * restrict old_data = it->__obj->data;
+
+  if (__dll_unlikely(!__dlli_cow(it->__dll))) {
+    return NULL;
+  }
+  __dlli_fp_unlink(it->__dll, it->__obj);
+  it->__obj->data       = data;
+  it->__obj->destructor = destructor;
+  __dlli_fp_link(it->__dll, it->__obj);
+
+  return old_data;
+}
+
+__dll_inline size_t dll_iterator_get_index(const dll_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return ~0UL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__index;
+}
+
+__dll_inline dll_iterator_t dll_front(dll_t * restrict dll) {
+  dll_iterator_t it = dll_iterator(dll);
+
+  return it;
+}
+
+__dll_inline dll_iterator_t dll_back(dll_t * restrict dll) {
+  dll_iterator_t it = {
+#ifndef LIBDLL_UNSAFE_USAGE
+      dll ? dll->tail : NULL,
+      dll,
+      0,
+#else
+      dll->tail,
+      dll,
+      dll->objs_count ? dll->objs_count - 1 : 0,
+#endif
+  };
+
+  return it;
+}
+
+__dll_inline bool dll_empty(const dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  return !(dll && !!dll->objs_count);
+#else
+  return !!dll->objs_count;
+#endif /* LIBDLL_UNSAFE_USAGE */
+}
+
+__dll_inline size_t dll_size(const dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return 0;
+  } else {
+    return dll->objs_count;
+  }
+#else
+  return dll->objs_count;
+#endif /* LIBDLL_UNSAFE_USAGE */
+}
+
+__dll_inline void * dll_obj_get_data(const dll_obj_t * restrict const obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == obj)) {
+    return NULL;
+  } else {
+    return obj->data;
+  }
+#else
+  return obj->data;
+#endif /* LIBDLL_UNSAFE_USAGE */
+}
+
+__dll_inline bool dll_merge(dll_t * restrict dst,
+                            dll_t * restrict src,
+                            dll_callback_ext_fn_t fn_sort,
+                            void *                fn_sort_any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dst || NULL == src)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * restrict iobj = src->head;
+  dll_obj_t * restrict save = NULL;
+
+  while (iobj) {
+    save = __dlli_next(src, iobj);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+    const dll_obj_t * const restrict __new_obj =
+        dll_emplace_back(dst, iobj->data, iobj->size, iobj->destructor);
+    if (__new_obj) {
+      const bool is_deleted_src = dll_delete(src, iobj);
+      if (false == is_deleted_src) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+#else
+    dll_emplace_back(dst, iobj->data, iobj->size, iobj->destructor);
+    dll_delete(src, iobj);
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+    iobj = save;
+  }
+
+  bool __ret = true;
+  if (NULL != fn_sort) {
+    __ret = dll_sort(dst, fn_sort, fn_sort_any);
+  }
+
+  return __ret;
+}
+
+/**
+ * \b Swaps back \c next and \c prev links of all list-objects in \p dll if the list
+ * was reversed with #dll_reverse , so the links follow the order of the list again.
+ *
+ * \param dll list.
+ *
+ * \return \c false if the newest snapshot of \p dll couldn't be copied, see #__dlli_cow .
+ */
+__dll_inline bool __dlli_normalize(dll_t * restrict dll) {
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return false;
+  }
+  if (!dll->__reversed) {
+    return true;
+  }
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj;) {
+    dll_obj_t * restrict save = iobj->prev;
+
+    iobj->prev = iobj->next;
+    iobj->next = save;
+    iobj       = save;
+  }
+
+  dll->__reversed = false;
+  return true;
+}
+
+__dll_inline bool dll_splice(dll_t * restrict const dst,
+                             dll_t * restrict const src,
+                             size_t dst_pos,
+                             size_t src_start,
+                             size_t src_end) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dst || NULL == src)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if ((src_end && src_start > src_end) || 0 == src->objs_count) {
+    return false;
+  }
+
+  if ((0 == dst_pos && 0 == src_start && 0 == src_end) ||
+      ((dst_pos >= dst->objs_count) && (src_start >= src->objs_count) &&
+       (0 == src_end))) {
+    const bool __ret = dll_merge(dst, src, NULL, NULL);
+
+    return __ret;
+  }
+
+  if (__dll_unlikely(!__dlli_normalize(dst) || !__dlli_normalize(src))) {
+    return false;
+  }
+  __dlli_compact_finish(src);
+  __dlli_skip_drop(dst);
+  __dlli_skip_drop(src);
+  __dlli_fp_stale(dst);
+  __dlli_fp_stale(src);
+
+  dll_obj_t * restrict dst_pos_obj = __dlli_get_obj_at_index(dst, dst_pos);
+  dll_obj_t * restrict src_pos_obj = __dlli_get_obj_at_index(src, src_start);
+  dll_obj_t * restrict src_pos_end_obj =
+      __dlli_get_obj_at_index(src, src_end ? src_end : src->objs_count);
+  size_t spliced_size = 0;
+
+  if (0 == src_start && 0 == src_end) {
+    spliced_size = src->objs_count;
+  } else if (src_start && 0 == src_end) {
+    spliced_size = src->objs_count - (src->objs_count - src_start);
+  } else {
+    spliced_size =
+        (src_end > src->objs_count ? src->objs_count : (src_end + 1)) - src_start;
+  }
+
+  dst->objs_count += spliced_size;
+  src->objs_count -= spliced_size;
+#ifdef LIBDLL_MEMORY
+  for (dll_obj_t * restrict iobj = src_pos_obj; iobj; iobj = iobj->next) {
+    __dlli_mem_unlink(src, iobj);
+    __dlli_mem_link(dst, iobj);
+    if (src_pos_end_obj == iobj) {
+      break;
+    }
+  }
+#endif /* LIBDLL_MEMORY */
+
+  if (NULL == src_pos_end_obj->next) {
+    src->tail = src_pos_obj->prev;
+  }
+  if (NULL == dst_pos_obj || (dst_pos_obj && NULL == dst_pos_obj->next)) {
+    dst->tail = src_pos_end_obj;
+  }
+  if (0 == src_start) {
+    src->head = src_pos_end_obj->next;
+  }
+
+  if (src_pos_obj->prev) {
+    src_pos_obj->prev->next = src_pos_end_obj->next;
+  }
+  if (dst_pos && dst_pos_obj->next) {
+    dst_pos_obj->next->prev = src_pos_end_obj;
+  }
+  if (0 == dst_pos) {
+    src_pos_end_obj->next = dst->head;
+    src_pos_obj->prev     = NULL;
+    dst->head             = src_pos_obj;
+  } else {
+    if (dst_pos_obj) {
+      src_pos_end_obj->next = dst_pos_obj->next;
+      src_pos_obj->prev     = dst_pos_obj;
+      dst_pos_obj->next     = src_pos_obj;
+    } else {
+      src_pos_end_obj->next = NULL;
+      src_pos_obj->prev     = NULL;
+      dst->head             = src_pos_obj;
+      dst->tail             = src_pos_end_obj;
+    }
+  }
+
+  return true;
+}
+
+__dll_inline size_t dll_remove(dll_t * restrict dll,
+                               dll_callback_fn_t fn_cmp,
+                               void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn_cmp)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * ahead        = __dlli_prefetch_start(dll, dll->head);
+  size_t      removed_objs = 0;
+  size_t      i            = 0;
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj;) {
+    dll_obj_t * restrict save = __dlli_next(dll, iobj);
+
+    ahead = __dlli_prefetch_step(dll, ahead);
+
+    const size_t fn_cmp_ret = fn_cmp(iobj->data, any, i++);
+    if (0 == fn_cmp_ret) {
+#ifndef LIBDLL_UNSAFE_USAGE
+      if (false == dll_delete(dll, iobj)) {
+        return 0;
+      }
+#else
+      dll_delete(dll, iobj);
+#endif
+      ++removed_objs;
+    }
+
+    iobj = save;
+  }
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat(dll, steps, i);
+  __dlli_stat(dll, calls, i);
+
+  return removed_objs;
+}
+
+__dll_inline size_t dll_partition(dll_t * restrict  src,
+                                  dll_callback_fn_t fn_cmp,
+                                  void * restrict   any,
+                                  dll_t * restrict  out_true,
+                                  dll_t * restrict  out_false) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == src || NULL == fn_cmp)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  // after this no unlink or push below can fail, so no list-object is lost half way
+  if (__dll_unlikely(!__dlli_cow(src) || (out_true && !__dlli_cow(out_true)) ||
+                     (out_false && !__dlli_cow(out_false)))) {
+    return 0;
+  }
+
+  dll_obj_t * ahead      = __dlli_prefetch_start(src, src->head);
+  size_t      moved_objs = 0;
+  size_t      i          = 0;
+
+  for (dll_obj_t * restrict iobj = src->head; iobj;) {
+    dll_obj_t * restrict save = __dlli_next(src, iobj);
+
+    ahead = __dlli_prefetch_step(src, ahead);
+
+    const ssize_t fn_cmp_ret = fn_cmp(iobj->data, any, i++);
+    dll_t * restrict out     = 0 == fn_cmp_ret ? out_true : out_false;
+
+    moved_objs += 0 == fn_cmp_ret;
+    if (out) {
+      dll_push_back(out, dll_unlink(src, iobj));
+    }
+
+    iobj = save;
+  }
+
+  return moved_objs;
+}
+
+__dll_inline size_t dll_remove_if_into(dll_t * restrict  src,
+                                       dll_callback_fn_t fn_cmp,
+                                       void * restrict   any,
+                                       dll_t * restrict  out) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const size_t __ret = dll_partition(src, fn_cmp, any, out, NULL);
+
+  return __ret;
+}
+
+__dll_inline bool dll_reverse(dll_t * restrict const dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(!dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * restrict head = dll->head;
+
+  __dlli_skip_drop(dll);
+  dll->head       = dll->tail;
+  dll->tail       = head;
+  dll->__reversed = !dll->__reversed;
+
+  return true;
+}
+
+__dll_inline bool dll_reverse_relink(dll_t * restrict const dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(!dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_reverse(dll);
+  const bool __ret = __dlli_normalize(dll);
+
+  return __ret;
+}
+
+__dll_inline void *
+    dll_find(dll_t * restrict dll, dll_callback_fn_t fn_search, void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn_search)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * ahead   = __dlli_prefetch_start(dll, dll->head);
+  void * restrict out = NULL;
+  size_t i            = 0;
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    ahead = __dlli_prefetch_step(dll, ahead);
+
+    const ssize_t fn_search_ret = fn_search(iobj->data, any, i++);
+    if (0 == fn_search_ret) {
+      out = iobj->data;
+      break;
+    }
+  }
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat(dll, steps, i);
+  __dlli_stat(dll, calls, i);
+
+  return out;
+}
+
+__dll_inline void ** dll_map(const dll_t * restrict const dll,
+                             dll_callback_mapper_fn_t mapper,
+                             void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == mapper || 0 == dll->objs_count)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  void ** mapped_array = (void **)calloc(dll->objs_count, sizeof(*mapped_array));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (!mapped_array) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * ahead = __dlli_prefetch_start(dll, dll->head);
+  size_t      i     = 0;
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj && dll->objs_count > i;
+       iobj                      = __dlli_next(dll, iobj), ++i) {
+    ahead = __dlli_prefetch_step(dll, ahead);
+
+    void * restrict new_data = mapper(iobj->data, any, i + 1);
+    mapped_array[i]          = new_data;
+  }
 
-  return __ret;
+  return mapped_array;
 }
 
-__dll_inline dll_obj_t * dll_emplace_back(dll_t * restrict dll,
-                                          void * restrict data,
-                                          size_t                       size,
-                                          dll_callback_destructor_fn_t destructor) {
-  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
-  dll_obj_t * restrict __ret   = dll_push_back(dll, new_obj);
+/**
+ * \b Gathers data of up to #LIBDLL_BATCH_SIZE list-objects of \p dll starting at
+ * \p iobj , prefetching the data so its loads overlap before the callback runs.
+ *
+ * \param dll list.
+ * \param iobj first list-object of the batch, moved to the list-object after the batch.
+ * \param objs list-objects of the batch, may be \c NULL if not needed.
+ * \param objs_data data of list-objects of the batch.
+ *
+ * \return count of gathered list-objects.
+ */
+__dll_inline size_t __dlli_gather_batch(const dll_t * restrict dll,
+                                        dll_obj_t ** restrict iobj,
+                                        dll_obj_t ** restrict objs,
+                                        void ** restrict objs_data) {
+  dll_obj_t * restrict obj = *iobj;
+  size_t count             = 0;
+
+  for (; obj && LIBDLL_BATCH_SIZE > count; obj = __dlli_next(dll, obj), ++count) {
+    __dll_prefetch(obj->data);
+    if (objs) {
+      objs[count] = obj;
+    }
+    objs_data[count] = obj->data;
+  }
 
-  return __ret;
+  *iobj = obj;
+  return count;
 }
 
-__dll_inline dll_obj_t * dll_pop_front(dll_t * restrict dll) {
+__dll_inline bool dll_foreach_batch(const dll_t * restrict dll,
+                                    dll_callback_batch_fn_t fn,
+                                    void * restrict any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == dll->head)) {
-    return NULL;
+  if (__dll_unlikely(NULL == dll || NULL == fn)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict head = dll->head;
+  void *      objs_data[LIBDLL_BATCH_SIZE];
+  dll_obj_t * iobj = dll->head;
+  size_t      i    = 0;
 
-  dll->head = head->next;
+  while (iobj) {
+    const size_t count = __dlli_gather_batch(dll, &iobj, NULL, objs_data);
 
-  dll_obj_t * restrict __ret = dll_unlink(dll, head);
+    fn(objs_data, NULL, count, any, i);
+    i += count;
+  }
 
-  return __ret;
+  return true;
 }
 
-__dll_inline dll_obj_t * dll_pop_back(dll_t * restrict dll) {
+__dll_inline void * dll_find_batch(const dll_t * restrict dll,
+                                   dll_callback_batch_fn_t fn_search,
+                                   void * restrict any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == dll->tail)) {
+  if (__dll_unlikely(NULL == dll || NULL == fn_search)) {
     return NULL;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict tail = dll->tail;
+  void *      objs_data[LIBDLL_BATCH_SIZE];
+  ssize_t     results[LIBDLL_BATCH_SIZE];
+  dll_obj_t * iobj = dll->head;
+  size_t      i    = 0;
 
-  dll->tail = tail->prev;
+  while (iobj) {
+    const size_t count = __dlli_gather_batch(dll, &iobj, NULL, objs_data);
 
-  dll_obj_t * restrict __ret = dll_unlink(dll, tail);
+    fn_search(objs_data, results, count, any, i);
+    for (size_t j = 0; count > j; ++j) {
+      if (0 == results[j]) {
+        return objs_data[j];
+      }
+    }
+    i += count;
+  }
 
-  return __ret;
+  return NULL;
 }
 
-__dll_inline bool dll_clear(dll_t * restrict dll) {
+__dll_inline size_t dll_remove_batch(dll_t * restrict dll,
+                                     dll_callback_batch_fn_t fn_cmp,
+                                     void * restrict any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll)) {
-    return false;
+  if (__dll_unlikely(NULL == dll || NULL == fn_cmp)) {
+    return 0;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  while (dll->objs_count) {
-    dll_obj_t * restrict obj = dll_pop_front(dll);
+  dll_obj_t * objs[LIBDLL_BATCH_SIZE];
+  void *      objs_data[LIBDLL_BATCH_SIZE];
+  ssize_t     results[LIBDLL_BATCH_SIZE];
+  dll_obj_t * iobj         = dll->head;
+  size_t      removed_objs = 0;
+  size_t      i            = 0;
 
-#ifndef LIBDLL_UNSAFE_USAGE
-    if (obj) {
-      const register bool is_obj_freed =
-#endif /* LIBDLL_UNSAFE_USAGE */
-          dll_free_obj(&obj);
+  while (iobj) {
+    const size_t count = __dlli_gather_batch(dll, &iobj, objs, objs_data);
 
+    fn_cmp(objs_data, results, count, any, i);
+    for (size_t j = 0; count > j; ++j) {
+      if (0 == results[j]) {
 #ifndef LIBDLL_UNSAFE_USAGE
-      if (!is_obj_freed) {
-        return false;
+        if (false == dll_delete(dll, objs[j])) {
+          return removed_objs;
+        }
+#else
+        dll_delete(dll, objs[j]);
+#endif /* LIBDLL_UNSAFE_USAGE */
+        ++removed_objs;
       }
-    } else {
-      return false;
     }
-#endif /* LIBDLL_UNSAFE_USAGE */
+    i += count;
   }
 
-  return true;
+  return removed_objs;
 }
 
-__dll_inline dll_obj_t *
-    dll_insert(dll_t * restrict dll, dll_obj_t * restrict obj, size_t pos) {
+__dll_inline size_t dll_unique(dll_t * restrict dll,
+                               dll_callback_ext_fn_t fn_cmp,
+                               void *                any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == obj)) {
-    return NULL;
+  if (__dll_unlikely(NULL == dll || NULL == fn_cmp)) {
+    return 0;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if (dll->objs_count < pos) {
-    return NULL;
-  }
+  dll_obj_t * restrict jobj = NULL;
+  dll_obj_t * restrict save = NULL;
+  size_t removed_objs       = 0;
+  size_t i                  = 0;
 
-  if (NULL == dll->head || 0 == pos) {
-    dll_obj_t * restrict __ret =
-        dll_emplace_front(dll, obj->data, obj->size, obj->destructor);
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    jobj = __dlli_next(dll, iobj);
 
-    return __ret;
-  } else {
-    dll_obj_t * restrict iter = dll->head;
+    while (jobj) {
+      save = __dlli_next(dll, jobj);
 
-    for (size_t i = 0; (pos - 1) > i && iter; ++i) {
-      iter = iter->next;
-    }
+      if (0 == fn_cmp(iobj->data, jobj->data, any, i)) {
+#ifndef LIBDLL_UNSAFE_USAGE
+        if (false == dll_delete(dll, jobj)) {
+          return false;
+        }
+#else
+        dll_delete(dll, jobj);
+#endif /* LIBDLL_UNSAFE_USAGE */
 
-    obj->next = iter->next;
-    obj->prev = iter;
-    if (iter->next) {
-      iter->next->prev = obj;
-    }
-    iter->next = obj;
+        ++removed_objs;
+      }
 
-    ++dll->objs_count;
+      jobj = save;
+    }
 
-    return obj;
+    ++i;
   }
-}
-
-__dll_inline dll_obj_t * dll_emplace(dll_t * restrict dll,
-                                     void * restrict data,
-                                     size_t                       size,
-                                     dll_callback_destructor_fn_t destructor,
-                                     size_t                       pos) {
-  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
-  dll_obj_t * restrict __ret   = dll_insert(dll, new_obj, pos);
 
-  return __ret;
+  return removed_objs;
 }
 
-__dll_inline dll_obj_t * __dlli_get_obj_at_index(dll_t * restrict dll, size_t pos) {
-  const size_t dll_size    = dll->objs_count;
-  dll_obj_t * restrict obj = NULL;
-
-  if ((dll_size / 2) >= pos) {
-    obj = dll->head;
-    for (size_t i = 0; obj && pos > i; ++i) {
-      obj = obj->next;
-    }
-  } else {
-    obj = dll->tail;
-    for (size_t i = dll_size ? dll_size - 1 : dll_size; obj && pos < i; --i) {
-      obj = obj->prev;
-    }
+/**
+ * \b Defines a \p _fname function, which sorts a chain of list-objects linked through
+ * \c next with an iterative bottom-up merge sort, fixing \c prev links on the way.
+ *
+ * \note Comparing expression \p _cmp sees data of two list-objects as \c a and \c b of
+ * \p _T pointer type, as well as \c fn_sort and \c any arguments of the function. Equal
+ * list-objects keep their order.
+ */
+#define __DLLI_DEFINE_MSORT(_fname, _T, _cmp)                                            \
+  __dll_inline dll_obj_t * _fname(dll_obj_t * head,                                      \
+                                  dll_obj_t ** tail_out,                                 \
+                                  dll_callback_ext_fn_t fn_sort,                         \
+                                  void * any) {                                          \
+    (void)fn_sort;                                                                       \
+    (void)any;                                                                           \
+                                                                                         \
+    dll_obj_t * tail = NULL;                                                             \
+                                                                                         \
+    for (size_t width = 1; head; width *= 2) {                                           \
+      dll_obj_t * p      = head;                                                         \
+      size_t      merges = 0;                                                            \
+                                                                                         \
+      head = tail = NULL;                                                                \
+      while (p) {                                                                        \
+        dll_obj_t * q     = p;                                                           \
+        size_t      psize = 0;                                                           \
+        size_t      qsize = width;                                                       \
+                                                                                         \
+        for (++merges; width > psize && q; ++psize) {                                    \
+          q = q->next;                                                                   \
+        }                                                                                \
+                                                                                         \
+        while (psize || (qsize && q)) {                                                  \
+          dll_obj_t * e = NULL;                                                          \
+                                                                                         \
+          if (0 == psize) {                                                              \
+            e = q, q = q->next, --qsize;                                                 \
+          } else if (0 == qsize || NULL == q) {                                          \
+            e = p, p = p->next, --psize;                                                 \
+          } else {                                                                       \
+            _T * a = (_T *)p->data;                                                      \
+            _T * b = (_T *)q->data;                                                      \
+                                                                                         \
+            if (0 >= (_cmp)) {                                                           \
+              e = p, p = p->next, --psize;                                               \
+            } else {                                                                     \
+              e = q, q = q->next, --qsize;                                               \
+            }                                                                            \
+          }                                                                              \
+                                                                                         \
+          if (tail) {                                                                    \
+            tail->next = e;                                                              \
+          } else {                                                                       \
+            head = e;                                                                    \
+          }                                                                              \
+          e->prev = tail;                                                                \
+          tail    = e;                                                                   \
+        }                                                                                \
+        p = q;                                                                           \
+      }                                                                                  \
+      tail->next = NULL;                                                                 \
+                                                                                         \
+      if (1 >= merges) {                                                                 \
+        break;                                                                           \
+      }                                                                                  \
+    }                                                                                    \
+                                                                                         \
+    *tail_out = tail;                                                                    \
+    return head;                                                                         \
   }
 
-  return obj;
+/**
+ * \b Sorts a chain of list-objects starting at \c head via \c fn_sort callback-function,
+ * storing the last list-object of sorted chain in \c tail_out .
+ */
+__DLLI_DEFINE_MSORT(__dlli_msort, void, fn_sort(a, b, any, ~0UL))
+
+#ifdef LIBDLL_STATS
+/**
+ * A comparator wrapped to count its calls, see #__DLLI_STATS_CMPS .
+ */
+typedef struct {
+  dll_callback_ext_fn_t fn;
+  void *                any;
+  size_t *              cmps;
+} __dlli_stats_cmp_t;
+
+/**
+ * \b Counts a call of the comparator wrapped into \p any and calls it.
+ */
+__dll_inline ssize_t __dlli_stats_cmp(void * restrict a,
+                                      void * restrict b,
+                                      void * restrict any,
+                                      size_t index) {
+  __dlli_stats_cmp_t * restrict cmp = (__dlli_stats_cmp_t *)any;
+
+  ++*cmp->cmps;
+  return cmp->fn(a, b, cmp->any, index);
 }
 
-__dll_inline dll_obj_t * dll_erase(dll_t * restrict dll, size_t start, size_t end) {
+/**
+ * Replaces comparator \p _fn and its \p _any data with a wrapper counting comparisons
+ * in the stats of \p _dll until the end of the enclosing block.
+ */
+#  define __DLLI_STATS_CMPS(_dll, _fn, _any)                                             \
+    __dlli_stats_cmp_t __stats_cmp = {(_fn), (_any), &(_dll)->stats.cmps};              \
+    (_fn)                          = __dlli_stats_cmp;                                   \
+    (_any)                         = &__stats_cmp
+#else
+#  define __DLLI_STATS_CMPS(_dll, _fn, _any) ((void)0)
+#endif /* LIBDLL_STATS */
+
+__dll_inline bool
+    dll_sort(dll_t * restrict dll, dll_callback_ext_fn_t fn_sort, void * any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll)) {
-    return NULL;
+  if (__dll_unlikely(NULL == dll || NULL == fn_sort)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if (0 == dll->objs_count || dll->objs_count < start) {
-    return NULL;
+  if (1 >= dll->objs_count) {
+    return true; // list already "sorted"
   }
 
-  dll_obj_t * restrict erasing = __dlli_get_obj_at_index(dll, start);
-  dll_obj_t * restrict save    = NULL;
-  size_t i                     = start ? start - 1 : start;
+  __dlli_probe_arg(sort_entry, dll, (uintptr_t)fn_sort);
+  __dlli_stat(dll, ops, 1);
+  __DLLI_STATS_CMPS(dll, fn_sort, any);
+  dll_obj_t * tail = NULL;
 
-  do {
-    save = erasing->next;
+  if (__dll_unlikely(!__dlli_normalize(dll))) {
+    __dlli_probe_arg(sort_return, dll, __dlli_stat_get(dll, cmps));
+    return false;
+  }
+  __dlli_skip_drop(dll);
+  __dlli_fp_stale(dll);
+  dll->head = __dlli_msort(dll->head, &tail, fn_sort, any);
+  dll->tail = tail;
 
-#ifndef LIBDLL_UNSAFE_USAGE
-    if (false == dll_delete(dll, erasing)) {
-      return NULL;
+  __dlli_probe_arg(sort_return, dll, __dlli_stat_get(dll, cmps));
+  return true;
+}
+
+/**
+ * \b Sifts down the list-object at \p i in a max-heap of \p count list-objects.
+ *
+ * \param heap list-objects heap.
+ * \param count heap size.
+ * \param i index of list-object to be sifted down.
+ * \param fn_sort callback-function to compare list-objects.
+ * \param any any data to be passed to fn_sort callback.
+ */
+__dll_inline void __dlli_heap_sift(dll_obj_t ** restrict heap,
+                                   size_t                count,
+                                   size_t                i,
+                                   dll_callback_ext_fn_t fn_sort,
+                                   void *                any) {
+  for (size_t child = 2 * i + 1; count > child; i = child, child = 2 * i + 1) {
+    if (count > child + 1 &&
+        0 > fn_sort(heap[child]->data, heap[child + 1]->data, any, ~0UL)) {
+      ++child;
+    }
+    if (0 <= fn_sort(heap[i]->data, heap[child]->data, any, ~0UL)) {
+      break;
     }
-#else
-    dll_delete(dll, erasing);
-#endif
 
-    erasing = save;
-  } while (end > i++ && erasing);
+    dll_obj_t * save = heap[i];
 
-  return erasing ? erasing : dll->tail;
+    heap[i]     = heap[child];
+    heap[child] = save;
+  }
 }
 
-__dll_inline bool
-    dll_foreach(const dll_t * restrict dll, dll_callback_fn_t fn, void * restrict any) {
+__dll_inline bool dll_partial_sort(dll_t * restrict      dll,
+                                   size_t                k,
+                                   dll_callback_ext_fn_t fn_sort,
+                                   void *                any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == fn)) {
+  if (__dll_unlikely(NULL == dll || NULL == fn_sort)) {
     return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  size_t i = 0;
+  if (k >= dll->objs_count) {
+    bool __ret = dll_sort(dll, fn_sort, any);
 
-  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = iobj->next) {
-    fn(iobj->data, any, i++);
+    return __ret;
+  }
+  if (0 == k) {
+    return true;
   }
 
-  return true;
-}
+  __dlli_stat(dll, ops, 1);
+  __DLLI_STATS_CMPS(dll, fn_sort, any);
+  dll_obj_t ** heap = (dll_obj_t **)calloc(k, sizeof(*heap));
+  if (__dll_unlikely(NULL == heap)) {
+    return false;
+  }
 
-__dll_inline dll_iterator_t dll_iterator(dll_t * restrict const dll) {
-  dll_iterator_t it = {
-#ifndef LIBDLL_UNSAFE_USAGE
-      dll ? dll->head : NULL,
-#else
-      dll->head,
-#endif
-      dll,
-      0};
+  __dlli_skip_drop(dll);
+  dll_obj_t * iobj = dll->head;
+  for (size_t i = 0; k > i; ++i, iobj = __dlli_next(dll, iobj)) {
+    heap[i] = iobj;
+  }
+  for (size_t i = k / 2; i--;) {
+    __dlli_heap_sift(heap, k, i, fn_sort, any);
+  }
 
-  return it;
-}
+  for (; iobj; iobj = __dlli_next(dll, iobj)) {
+    if (0 > fn_sort(iobj->data, heap[0]->data, any, ~0UL)) {
+      heap[0] = iobj;
+      __dlli_heap_sift(heap, k, 0, fn_sort, any);
+    }
+  }
 
-__dll_inline bool dll_next(dll_iterator_t * restrict const it) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it || (it && NULL == it->__dll))) {
-    return false;
+  for (size_t i = k - 1; i; --i) {
+    dll_obj_t * save = heap[0];
+
+    heap[0] = heap[i];
+    heap[i] = save;
+    __dlli_heap_sift(heap, i, 0, fn_sort, any);
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
 
-  it->__obj = it->__obj ? it->__obj->next : NULL;
-  ++it->__index;
+  for (size_t i = k; i--;) {
+    dll_push_front(dll, dll_unlink(dll, heap[i]));
+  }
 
-  return !!it->__obj;
+  free(heap);
+  return true;
 }
 
-__dll_inline bool dll_prev(dll_iterator_t * restrict const it) {
+__dll_inline dll_obj_t * dll_nth_element(dll_t * restrict      dll,
+                                         size_t                n,
+                                         dll_callback_ext_fn_t fn_sort,
+                                         void *                any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it || (it && NULL == it->__dll))) {
-    return false;
+  if (__dll_unlikely(NULL == dll || NULL == fn_sort)) {
+    return NULL;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  it->__obj = it->__obj ? it->__obj->prev : NULL;
-  --it->__index;
+  if (n >= dll->objs_count) {
+    return NULL;
+  }
 
-  return !!it->__obj;
+  __dlli_stat(dll, ops, 1);
+  __DLLI_STATS_CMPS(dll, fn_sort, any);
+  const size_t count = dll->objs_count;
+  dll_obj_t ** objs  = (dll_obj_t **)calloc(count, sizeof(*objs));
+  if (__dll_unlikely(NULL == objs)) {
+    return NULL;
+  }
+  if (__dll_unlikely(!__dlli_normalize(dll))) {
+    free(objs);
+    return NULL;
+  }
+  __dlli_skip_drop(dll);
+  __dlli_fp_stale(dll);
+
+  dll_obj_t * iobj = dll->head;
+  for (size_t i = 0; count > i; ++i, iobj = iobj->next) {
+    objs[i] = iobj;
+  }
+
+  for (size_t lo = 0, hi = count - 1; lo < hi;) {
+    size_t mid = lo + (hi - lo) / 2;
+
+    // median of three, so sorted and reversed lists don't degrade to O(n^2)
+    if (0 > fn_sort(objs[mid]->data, objs[lo]->data, any, ~0UL)) {
+      iobj = objs[mid], objs[mid] = objs[lo], objs[lo] = iobj;
+    }
+    if (0 > fn_sort(objs[hi]->data, objs[lo]->data, any, ~0UL)) {
+      iobj = objs[hi], objs[hi] = objs[lo], objs[lo] = iobj;
+    }
+    if (0 > fn_sort(objs[hi]->data, objs[mid]->data, any, ~0UL)) {
+      iobj = objs[hi], objs[hi] = objs[mid], objs[mid] = iobj;
+    }
+
+    void * pivot = objs[mid]->data;
+    size_t i     = lo;
+    size_t j     = hi;
+
+    while (i <= j) {
+      while (0 > fn_sort(objs[i]->data, pivot, any, ~0UL)) {
+        ++i;
+      }
+      while (0 < fn_sort(objs[j]->data, pivot, any, ~0UL)) {
+        --j;
+      }
+      if (i <= j) {
+        iobj = objs[i], objs[i] = objs[j], objs[j] = iobj;
+        ++i;
+        if (0 == j) {
+          break;
+        }
+        --j;
+      }
+    }
+
+    if (n <= j) {
+      hi = j;
+    } else if (n >= i) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+
+  dll_obj_t * prev = NULL;
+  for (size_t i = 0; count > i; ++i) {
+    objs[i]->prev = prev;
+    if (prev) {
+      prev->next = objs[i];
+    }
+    prev = objs[i];
+  }
+  prev->next = NULL;
+  dll->head  = objs[0];
+  dll->tail  = prev;
+
+  dll_obj_t * restrict __ret = objs[n];
+
+  free(objs);
+  return __ret;
 }
 
-__dll_inline dll_obj_t * dll_iterator_get_obj(const dll_iterator_t * restrict const it) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it)) {
-    return NULL;
+__dll_inline bool
+    dll_set_sorted(dll_t * restrict dll, dll_callback_ext_fn_t fn_cmp, void * any) {
+#ifdef LIBDLL_SORTED
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
+#  endif /* LIBDLL_UNSAFE_USAGE */
 
-  return it->__obj;
-}
+  __dlli_skip_drop(dll);
+  dll->__sorted_cmp = fn_cmp;
+  dll->__sorted_any = any;
 
-__dll_inline void * dll_iterator_get_data(const dll_iterator_t * restrict const it) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it)) {
-    return NULL;
+  bool __ret = true;
+  if (NULL != fn_cmp) {
+    __ret = dll_sort(dll, fn_cmp, any);
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
 
-  return it->__obj->data;
+  return __ret;
+#else
+  (void)dll;
+  (void)fn_cmp;
+  (void)any;
+  return false;
+#endif /* LIBDLL_SORTED */
 }
 
-__dll_inline void * dll_iterator_set_data(const dll_iterator_t * restrict const it,
-                                          void * restrict data,
-                                          dll_callback_destructor_fn_t destructor) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it)) {
+__dll_inline dll_obj_t *
+    dll_insert_sorted(dll_t * restrict dll, dll_obj_t * restrict obj) {
+#ifdef LIBDLL_SORTED
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == obj || NULL == dll->__sorted_cmp)) {
     return NULL;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
+#  endif /* LIBDLL_UNSAFE_USAGE */
 
-  void * restrict old_data = it->__obj->data;
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return NULL;
+  }
 
-  it->__obj->data       = data;
-  it->__obj->destructor = destructor;
+  dll_skip_t *         update[LIBDLL_SKIP_LEVELS];
+  dll_obj_t * restrict next = __dlli_skip_seek(dll, obj->data, true, update);
+  dll_obj_t * restrict prev = next ? __dlli_prev(dll, next) : dll->tail;
 
-  return old_data;
-}
+  obj->next = NULL;
+  obj->prev = NULL;
 
-__dll_inline size_t dll_iterator_get_index(const dll_iterator_t * restrict const it) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == it)) {
-    return ~0UL;
+  __dlli_next(dll, obj) = next;
+  __dlli_prev(dll, obj) = prev;
+  if (prev) {
+    __dlli_next(dll, prev) = obj;
+  } else {
+    dll->head = obj;
+  }
+  if (next) {
+    __dlli_prev(dll, next) = obj;
+  } else {
+    dll->tail = obj;
+  }
+  ++dll->objs_count;
+  __dlli_mem_link(dll, obj);
+  __dlli_fp_link(dll, obj);
+  __dlli_stat(dll, ops, 1);
+  __dlli_stat_len(dll);
+
+  const size_t height = dll->__skip ? __dlli_skip_height(obj) : 0;
+  dll_skip_t * tower  = height ? __dlli_skip_tower_new(dll, obj, height) : NULL;
+
+  if (tower) {
+    for (size_t l = 0; height > l; ++l) {
+      tower->__next[l]     = update[l]->__next[l];
+      update[l]->__next[l] = tower;
+    }
+  } else if (__dll_unlikely(height)) {
+    // unlinking finds towers by their height, so the overlay is rebuilt on next search
+    __dlli_skip_drop(dll);
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
 
-  return it->__index;
+  return obj;
+#else
+  (void)dll;
+  (void)obj;
+  return NULL;
+#endif /* LIBDLL_SORTED */
 }
 
-__dll_inline dll_iterator_t dll_front(dll_t * restrict dll) {
-  dll_iterator_t it = dll_iterator(dll);
+__dll_inline dll_obj_t * dll_emplace_sorted(dll_t * restrict dll,
+                                            void * restrict data,
+                                            size_t                       size,
+                                            dll_callback_destructor_fn_t destructor) {
+  dll_obj_t * restrict new_obj = dll_new_obj(data, size, destructor);
+  dll_obj_t * restrict __ret   = dll_insert_sorted(dll, new_obj);
 
-  return it;
+  if (__ret) {
+    __dlli_stat(dll, allocs, 1);
+  } else {
+    free(new_obj);
+  }
+  return __ret;
 }
 
-__dll_inline dll_iterator_t dll_back(dll_t * restrict dll) {
-  dll_iterator_t it = {
-#ifndef LIBDLL_UNSAFE_USAGE
-      dll ? dll->tail : NULL,
-      dll,
-      0,
-#else
-      dll->tail,
-      dll,
-      dll->objs_count ? dll->objs_count - 1 : 0,
-#endif
-  };
-
-  return it;
-}
+__dll_inline dll_obj_t * dll_lower_bound(dll_t * restrict dll, void * key) {
+#ifdef LIBDLL_SORTED
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == dll->__sorted_cmp)) {
+    return NULL;
+  }
+#  endif /* LIBDLL_UNSAFE_USAGE */
 
-__dll_inline bool dll_empty(const dll_t * restrict dll) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  return !(dll && !!dll->objs_count);
-#else
-  return !!dll->objs_count;
-#endif /* LIBDLL_UNSAFE_USAGE */
-}
+  dll_obj_t * restrict __ret = __dlli_skip_seek(dll, key, false, NULL);
 
-__dll_inline size_t dll_size(const dll_t * restrict dll) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll)) {
-    return 0;
-  } else {
-    return dll->objs_count;
-  }
+  return __ret;
 #else
-  return dll->objs_count;
-#endif /* LIBDLL_UNSAFE_USAGE */
+  (void)dll;
+  (void)key;
+  return NULL;
+#endif /* LIBDLL_SORTED */
 }
 
-__dll_inline void * dll_obj_get_data(const dll_obj_t * restrict const obj) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == obj)) {
+__dll_inline dll_obj_t * dll_upper_bound(dll_t * restrict dll, void * key) {
+#ifdef LIBDLL_SORTED
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == dll->__sorted_cmp)) {
     return NULL;
-  } else {
-    return obj->data;
   }
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * restrict __ret = __dlli_skip_seek(dll, key, true, NULL);
+
+  return __ret;
 #else
-  return obj->data;
-#endif /* LIBDLL_UNSAFE_USAGE */
+  (void)dll;
+  (void)key;
+  return NULL;
+#endif /* LIBDLL_SORTED */
 }
 
-__dll_inline bool dll_merge(dll_t * restrict dst,
-                            dll_t * restrict src,
-                            dll_callback_ext_fn_t fn_sort,
-                            void *                fn_sort_any) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dst || NULL == src)) {
-    return false;
+__dll_inline size_t dll_foreach_range(dll_t * restrict  dll,
+                                      void *            from,
+                                      void *            to,
+                                      dll_callback_fn_t fn,
+                                      void * restrict   any) {
+#ifdef LIBDLL_SORTED
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn || NULL == dll->__sorted_cmp)) {
+    return 0;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
+#  endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict iobj = src->head;
-  dll_obj_t * restrict save = NULL;
+  dll_obj_t * iobj = from ? __dlli_skip_seek(dll, from, false, NULL) : dll->head;
+  size_t      i    = 0;
 
-  while (iobj) {
-    save = iobj->next;
+  for (; iobj && (NULL == to ||
+                  0 > dll->__sorted_cmp(iobj->data, to, dll->__sorted_any, ~0UL));
+       iobj = __dlli_next(dll, iobj)) {
+    fn(iobj->data, any, i++);
+  }
 
-#ifndef LIBDLL_UNSAFE_USAGE
-    const dll_obj_t * const restrict __new_obj =
-        dll_emplace_back(dst, iobj->data, iobj->size, iobj->destructor);
-    if (__new_obj) {
-      const bool is_deleted_src = dll_delete(src, iobj);
-      if (false == is_deleted_src) {
-        return false;
-      }
-    } else {
-      return false;
-    }
+  return i;
 #else
-    dll_emplace_back(dst, iobj->data, iobj->size, iobj->destructor);
-    dll_delete(src, iobj);
-#endif /* LIBDLL_UNSAFE_USAGE */
-
-    iobj = save;
-  }
+  (void)dll;
+  (void)from;
+  (void)to;
+  (void)fn;
+  (void)any;
+  return 0;
+#endif /* LIBDLL_SORTED */
+}
 
-  bool __ret = true;
-  if (NULL != fn_sort) {
-    __ret = dll_sort(dst, fn_sort, fn_sort_any);
+/**
+ * \b Compares list-objects \p a and \p b by their \c size and \c size bytes of their
+ * \c data , see #LIBDLL_CMP_BYTES .
+ *
+ * \param a list-object.
+ * \param b list-object.
+ *
+ * \return \c true if they are equal.
+ */
+__dll_inline bool __dlli_bytes_equal(const dll_obj_t * restrict a,
+                                     const dll_obj_t * restrict b) {
+  if (a->size != b->size || a->data == b->data || 0 == a->size) {
+    return a->size == b->size;
   }
 
-  return __ret;
+  return a->data && b->data && 0 == memcmp(a->data, b->data, a->size);
 }
 
-__dll_inline bool dll_splice(dll_t * restrict const dst,
-                             dll_t * restrict const src,
-                             size_t dst_pos,
-                             size_t src_start,
-                             size_t src_end) {
+__dll_inline bool dll_is_equal(const dll_t * restrict const dll_a,
+                               const dll_t * restrict const dll_b,
+                               dll_callback_ext_fn_t fn_cmp,
+                               void * restrict any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dst || NULL == src)) {
+  if (__dll_unlikely(NULL == dll_a || NULL == dll_b)) {
     return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if ((src_end && src_start > src_end) || 0 == src->objs_count) {
+  if (dll_a->objs_count != dll_b->objs_count) {
     return false;
   }
-
-  if ((0 == dst_pos && 0 == src_start && 0 == src_end) ||
-      ((dst_pos >= dst->objs_count) && (src_start >= src->objs_count) &&
-       (0 == src_end))) {
-    const bool __ret = dll_merge(dst, src, NULL, NULL);
-
-    return __ret;
+#ifdef LIBDLL_FINGERPRINT
+  if ((NULL == fn_cmp || LIBDLL_CMP_BYTES == fn_cmp) && !dll_a->__fp_stale &&
+      !dll_b->__fp_stale && dll_a->__fingerprint != dll_b->__fingerprint) {
+    return false;
   }
+#endif /* LIBDLL_FINGERPRINT */
 
-  dll_obj_t * restrict dst_pos_obj = __dlli_get_obj_at_index(dst, dst_pos);
-  dll_obj_t * restrict src_pos_obj = __dlli_get_obj_at_index(src, src_start);
-  dll_obj_t * restrict src_pos_end_obj =
-      __dlli_get_obj_at_index(src, src_end ? src_end : src->objs_count);
-  size_t spliced_size = 0;
+  dll_obj_t * restrict iobj_a = dll_a->head;
+  dll_obj_t * restrict iobj_b = dll_b->head;
+  dll_obj_t * ahead_a         = __dlli_prefetch_start(dll_a, iobj_a);
+  dll_obj_t * ahead_b         = __dlli_prefetch_start(dll_b, iobj_b);
+  size_t i                    = 0;
 
-  if (0 == src_start && 0 == src_end) {
-    spliced_size = src->objs_count;
-  } else if (src_start && 0 == src_end) {
-    spliced_size = src->objs_count - (src->objs_count - src_start);
-  } else {
-    spliced_size =
-        (src_end > src->objs_count ? src->objs_count : (src_end + 1)) - src_start;
+  for (; iobj_a && iobj_b;
+       iobj_a = __dlli_next(dll_a, iobj_a), iobj_b = __dlli_next(dll_b, iobj_b)) {
+    ahead_a = __dlli_prefetch_step(dll_a, ahead_a);
+    ahead_b = __dlli_prefetch_step(dll_b, ahead_b);
+
+    if (LIBDLL_CMP_BYTES == fn_cmp) {
+      if (!__dlli_bytes_equal(iobj_a, iobj_b)) {
+        return false;
+      }
+    } else if (fn_cmp) {
+      if (0 != fn_cmp(iobj_a->data, iobj_b->data, any, i++)) {
+        return false;
+      }
+    } else {
+      if (iobj_a->size != iobj_b->size || iobj_a->data != iobj_b->data) {
+        return false;
+      }
+    }
   }
 
-  dst->objs_count += spliced_size;
-  src->objs_count -= spliced_size;
+  return !(iobj_a || iobj_b);
+}
 
-  if (NULL == src_pos_end_obj->next) {
-    src->tail = src_pos_obj->prev;
-  }
-  if (NULL == dst_pos_obj || (dst_pos_obj && NULL == dst_pos_obj->next)) {
-    dst->tail = src_pos_end_obj;
-  }
-  if (0 == src_start) {
-    src->head = src_pos_end_obj->next;
-  }
+__dll_inline bool dll_delete(dll_t * restrict dll, dll_obj_t * restrict obj) {
+  dll_obj_t * restrict del_obj = dll_unlink(dll, obj);
 
-  if (src_pos_obj->prev) {
-    src_pos_obj->prev->next = src_pos_end_obj->next;
+  if (__dll_unlikely(NULL == del_obj)) {
+    return false;
   }
-  if (dst_pos && dst_pos_obj->next) {
-    dst_pos_obj->next->prev = src_pos_end_obj;
+
+  __dlli_stat(dll, frees, 1);
+  if (dll->__snapshot) {
+    __dlli_retire(dll->__snapshot, del_obj, del_obj);
+    return true;
   }
-  if (0 == dst_pos) {
-    src_pos_end_obj->next = dst->head;
-    src_pos_obj->prev     = NULL;
-    dst->head             = src_pos_obj;
-  } else {
-    if (dst_pos_obj) {
-      src_pos_end_obj->next = dst_pos_obj->next;
-      src_pos_obj->prev     = dst_pos_obj;
-      dst_pos_obj->next     = src_pos_obj;
-    } else {
-      src_pos_end_obj->next = NULL;
-      src_pos_obj->prev     = NULL;
-      dst->head             = src_pos_obj;
-      dst->tail             = src_pos_end_obj;
-    }
+  if (dll->__reclaimer) {
+    __dlli_reclaim(dll->__reclaimer, del_obj, del_obj);
+    return true;
   }
 
-  return true;
+  const bool __ret = dll_free_obj(&del_obj);
+
+  return __ret;
 }
 
-__dll_inline size_t dll_remove(dll_t * restrict dll,
-                               dll_callback_fn_t fn_cmp,
-                               void * restrict any) {
+__dll_inline dll_obj_t * dll_unlink(dll_t * restrict dll, dll_obj_t * restrict obj) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == fn_cmp)) {
-    return 0;
+  if (__dll_unlikely(NULL == dll || NULL == obj)) {
+    return NULL;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  size_t removed_objs = 0;
-  size_t i            = 0;
-
-  for (dll_obj_t * restrict iobj = dll->head; iobj;) {
-    dll_obj_t * restrict save = iobj->next;
-
-    const size_t fn_cmp_ret = fn_cmp(iobj->data, any, i++);
-    if (0 == fn_cmp_ret) {
-#ifndef LIBDLL_UNSAFE_USAGE
-      if (false == dll_delete(dll, iobj)) {
-        return 0;
-      }
-#else
-      dll_delete(dll, iobj);
-#endif
-      ++removed_objs;
-    }
-
-    iobj = save;
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return NULL;
   }
 
-  return removed_objs;
-}
+  __dlli_probe_arg(unlink_entry, dll, obj);
+#ifdef LIBDLL_COMPACT
+  if (__dll_unlikely(obj == dll->__compact_next)) {
+    dll->__compact_next = __dlli_next(dll, obj);
+  }
+#endif /* LIBDLL_COMPACT */
+#ifdef LIBDLL_SORTED
+  __dlli_skip_remove(dll, obj);
+#endif /* LIBDLL_SORTED */
+  __dlli_fp_unlink(dll, obj);
+
+  if (__dlli_prev(dll, obj)) {
+    __dlli_next(dll, __dlli_prev(dll, obj)) = __dlli_next(dll, obj);
+  } else {
+    dll->head = __dlli_next(dll, obj);
+  }
 
-/**
- * \b Copying all the data of list-object \p src to \p dst.
- *
- * \attention This variation of memcpy(3) copies only internal data without
- * previous\next list pointers.
- *
- * \param dst destination
- * \param src source
- */
-__dll_inline void __dlli_memcpy(dll_obj_t * restrict dst, dll_obj_t * restrict src) {
-  unsigned char * restrict dstptr = (unsigned char * restrict)dst;
-  unsigned char * restrict srcptr = (unsigned char * restrict)src;
-  const size_t offsetnp           = offsetof(dll_obj_t, data);
-  const size_t copysize           = sizeof(*dst) - offsetnp;
+  if (__dlli_next(dll, obj)) {
+    __dlli_prev(dll, __dlli_next(dll, obj)) = __dlli_prev(dll, obj);
+  } else {
+    dll->tail = __dlli_prev(dll, obj);
+  }
+
+  obj->prev = NULL;
+  obj->next = NULL;
+  --dll->objs_count;
+  __dlli_mem_unlink(dll, obj);
+  __dlli_stat(dll, ops, 1);
 
-  memcpy(dstptr + offsetnp, srcptr + offsetnp, copysize);
+  __dlli_probe_arg(unlink_return, dll, obj);
+  return obj;
 }
 
-__dll_inline bool dll_reverse(const dll_t * restrict const dll) {
+__dll_inline bool dll_free_obj(dll_obj_t * restrict * restrict obj) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(!dll)) {
+  if (__dll_unlikely(NULL == obj || NULL == *obj)) {
     return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  for (dll_obj_t * restrict ifirst = dll->head, * restrict ilast = dll->tail;
-       ifirst && ilast && ifirst != ilast;
-       ifirst = ifirst->next, ilast = ilast->prev) {
-    dll_obj_t temp = *ifirst;
-    __dlli_memcpy(ifirst, ilast);
-    __dlli_memcpy(ilast, &temp);
-  }
+  __dlli_destroy_obj(*obj);
 
+  *obj = NULL;
   return true;
 }
 
-__dll_inline void *
-    dll_find(dll_t * restrict dll, dll_callback_fn_t fn_search, void * restrict any) {
+__dll_inline bool dll_free(dll_t * restrict * restrict dll) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == fn_search)) {
-    return NULL;
+  if (__dll_unlikely(NULL == dll || NULL == *dll)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  void * restrict out = NULL;
-  size_t i            = 0;
+  __dlli_probe(free_entry, *dll);
+  const bool __ret = dll_clear(*dll);
 
-  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = iobj->next) {
-    const ssize_t fn_search_ret = fn_search(iobj->data, any, i++);
-    if (0 == fn_search_ret) {
-      out = iobj->data;
-      break;
-    }
+  if (__dll_unlikely(!__ret)) {
+    __dlli_probe(free_return, *dll);
+    return false;
+  }
+
+  for (dll_snapshot_t * isnap = (*dll)->__snapshot; isnap; isnap = isnap->__older) {
+    isnap->__dll = NULL;
   }
+  __dlli_probe(free_return, *dll);
+  free(*dll);
+  *dll = NULL;
+
+  return __ret;
+}
+
+__dll_inline dll_reclaimer_t * dll_reclaimer_new(void) {
+  dll_reclaimer_t * restrict out = (dll_reclaimer_t *)calloc(1, sizeof(*out));
 
   return out;
 }
 
-__dll_inline void ** dll_map(const dll_t * restrict const dll,
-                             dll_callback_mapper_fn_t mapper,
-                             void * restrict any) {
+__dll_inline bool dll_set_reclaimer(dll_t * restrict dll,
+                                    dll_reclaimer_t * restrict reclaimer) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == mapper || 0 == dll->objs_count)) {
-    return NULL;
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  void ** mapped_array = calloc(dll->objs_count, sizeof(*mapped_array));
+  dll->__reclaimer = reclaimer;
+  return true;
+}
 
+__dll_inline size_t dll_reclaim_step(dll_reclaimer_t * restrict reclaimer, size_t budget) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (!mapped_array) {
-    return NULL;
+  if (__dll_unlikely(NULL == reclaimer)) {
+    return 0;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  size_t i = 0;
-  for (dll_obj_t * restrict iobj = dll->head; iobj && dll->objs_count > i;
-       iobj                      = iobj->next, ++i) {
-    void * restrict new_data = mapper(iobj->data, any, i + 1);
-    mapped_array[i]          = new_data;
+  size_t freed_objs = 0;
+
+  while (0 == budget || budget > freed_objs) {
+    if (NULL == reclaimer->__current) {
+      reclaimer->__current =
+          __atomic_exchange_n(&reclaimer->__pending, NULL, __ATOMIC_ACQUIRE);
+      if (NULL == reclaimer->__current) {
+        break;
+      }
+    }
+
+    dll_obj_t * restrict obj = reclaimer->__current;
+
+    reclaimer->__current = obj->next;
+    dll_free_obj(&obj);
+    ++freed_objs;
   }
 
-  return mapped_array;
+  return freed_objs;
 }
 
-__dll_inline size_t dll_unique(dll_t * restrict dll,
-                               dll_callback_ext_fn_t fn_cmp,
-                               void *                any) {
+__dll_inline bool dll_reclaimer_free(dll_reclaimer_t * restrict * restrict reclaimer) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == fn_cmp)) {
-    return 0;
+  if (__dll_unlikely(NULL == reclaimer || NULL == *reclaimer)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict jobj = NULL;
-  dll_obj_t * restrict save = NULL;
-  size_t removed_objs       = 0;
-  size_t i                  = 0;
+  dll_reclaim_step(*reclaimer, 0);
 
-  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = iobj->next) {
-    jobj = iobj->next;
+  free(*reclaimer);
+  *reclaimer = NULL;
 
-    while (jobj) {
-      save = jobj->next;
+  return true;
+}
 
-      if (0 == fn_cmp(iobj->data, jobj->data, any, i)) {
-#ifndef LIBDLL_UNSAFE_USAGE
-        if (false == dll_delete(dll, jobj)) {
-          return false;
-        }
-#else
-        dll_delete(dll, jobj);
-#endif /* LIBDLL_UNSAFE_USAGE */
+__dll_inline bool
+    dll_compact(dll_t * restrict dll, dll_callback_relocate_fn_t fn, void * restrict any) {
+  const bool __ret = dll_compact_step(dll, 0, fn, any);
 
-        ++removed_objs;
+  return __ret;
+}
+
+__dll_inline bool dll_compact_step(dll_t * restrict dll,
+                                   size_t budget,
+                                   dll_callback_relocate_fn_t fn,
+                                   void * restrict any) {
+#ifdef LIBDLL_COMPACT
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return false;
+  }
+  // towers are found by the height of list-objects, which depends on their address
+  __dlli_skip_drop(dll);
+  if (NULL == dll->__compact_block) {
+    if (NULL == dll->head) {
+      return true;
+    }
+    if (NULL == (dll->__compact_block = __dlli_block_new())) {
+      return false;
+    }
+    dll->__compact_next = dll->head;
+  }
+
+  size_t relocated_objs = 0;
+
+  while (dll->__compact_next && (0 == budget || budget > relocated_objs)) {
+    if (__DLLI_BLOCK_OBJS == dll->__compact_block->__used) {
+      dll_block_t * restrict block = __dlli_block_new();
+
+      if (NULL == block) {
+        return false;
       }
+      __dlli_block_release(dll->__compact_block, 1);
+      dll->__compact_block = block;
+    }
 
-      jobj = save;
+    dll_obj_t * old_obj = dll->__compact_next;
+    dll_obj_t * obj     = __dlli_block_take(dll->__compact_block);
+
+    *obj = *old_obj;
+    __dlli_mem_unlink(dll, old_obj);
+    __dlli_mem_link(dll, obj);
+
+    if (obj->prev) {
+      obj->prev->next = obj;
+    }
+    if (obj->next) {
+      obj->next->prev = obj;
+    }
+    if (old_obj == dll->head) {
+      dll->head = obj;
+    }
+    if (old_obj == dll->tail) {
+      dll->tail = obj;
     }
 
-    ++i;
+    dll->__compact_next = __dlli_next(dll, obj);
+    if (fn) {
+      fn(old_obj, obj, any);
+    }
+    __dlli_release_obj(old_obj);
+
+    ++relocated_objs;
   }
 
-  return removed_objs;
+  if (NULL == dll->__compact_next) {
+    __dlli_compact_finish(dll);
+    return true;
+  }
+
+  return false;
+#else
+  (void)dll;
+  (void)budget;
+  (void)fn;
+  (void)any;
+  return false;
+#endif /* LIBDLL_COMPACT */
 }
 
-__dll_inline dll_obj_t * __dlli_msort(dll_obj_t * restrict first,
-                                      dll_obj_t * restrict second,
-                                      dll_callback_ext_fn_t fn_sort,
-                                      void *                any) {
-  if (NULL == first) {
-    return second;
+__dll_inline dll_snapshot_t * dll_snapshot(dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (dll->__snapshot && dll->__snapshot->__shared) {
+    ++dll->__snapshot->__refs;
+    return dll->__snapshot;
   }
-  if (NULL == second) {
-    return first;
+
+  dll_snapshot_t * restrict snap = (dll_snapshot_t *)calloc(1, sizeof(*snap));
+  if (__dll_unlikely(NULL == snap)) {
+    return NULL;
   }
 
-  const ssize_t fn_sort_ret = fn_sort(first->data, second->data, any, ~0UL);
-  if (0 > fn_sort_ret) {
-    first->next       = __dlli_msort(first->next, second, fn_sort, any);
-    first->next->prev = first;
-    first->prev       = NULL;
-    return first;
-  } else {
-    second->next       = __dlli_msort(first, second->next, fn_sort, any);
-    second->next->prev = second;
-    second->prev       = NULL;
-    return second;
+  snap->head       = dll->head;
+  snap->tail       = dll->tail;
+  snap->objs_count = dll->objs_count;
+  snap->__shared   = true;
+  snap->__reversed = dll->__reversed;
+  snap->__refs     = 1;
+  snap->__dll      = dll;
+  snap->__older    = dll->__snapshot;
+  if (snap->__older) {
+    snap->__older->__newer = snap;
   }
+  dll->__snapshot = snap;
+
+  return snap;
 }
 
-__dll_inline dll_obj_t * __dlli_msort_parts(dll_obj_t * restrict head,
-                                            dll_callback_ext_fn_t fn_sort,
-                                            void *                any) {
-  if (NULL == head || NULL == head->next) {
-    return head;
+__dll_inline size_t dll_snapshot_size(const dll_snapshot_t * restrict snap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == snap)) {
+    return 0;
   }
+#endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict ifast = head;
-  dll_obj_t * restrict islow = head;
+  return snap->objs_count;
+}
 
-  while (ifast->next && ifast->next->next) {
-    ifast = ifast->next->next;
-    islow = islow->next;
-  }
+/**
+ * \b Moves the snapshot iterator \p it from a list-object shared with the list to its
+ * copy, if the snapshot was copied since the last step of \p it .
+ *
+ * \param it snapshot iterator.
+ */
+__dll_inline void __dlli_snapshot_sync(dll_snapshot_iterator_t * restrict it) {
+  const dll_snapshot_t * restrict snap = it->__snap;
 
-  dll_obj_t * restrict half = islow->next;
-  islow->next               = NULL;
+  if (__dll_likely(it->__copied || snap->__shared)) {
+    return;
+  }
 
-  head = __dlli_msort_parts(head, fn_sort, any);
-  half = __dlli_msort_parts(half, fn_sort, any);
+  it->__copied = true;
+  it->__obj    = NULL;
+  if (snap->objs_count > it->__index) {
+    dll_block_t * restrict block = snap->__segments[it->__index / __DLLI_BLOCK_OBJS];
 
-  return __dlli_msort(head, half, fn_sort, any);
+    it->__obj = (dll_obj_t *)(block + 1) + it->__index % __DLLI_BLOCK_OBJS;
+  }
 }
 
-__dll_inline bool
-    dll_sort(dll_t * restrict dll, dll_callback_ext_fn_t fn_sort, void * any) {
+__dll_inline bool dll_snapshot_foreach(const dll_snapshot_t * restrict snap,
+                                       dll_callback_fn_t fn,
+                                       void * restrict any) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == fn_sort)) {
+  if (__dll_unlikely(NULL == snap || NULL == fn)) {
     return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if (1 >= dll->objs_count) {
-    return true; // list already "sorted"
-  }
-
-  dll->head = __dlli_msort_parts(dll->head, fn_sort, any);
+  dll_snapshot_iterator_t it = dll_snapshot_iterator(snap);
 
-  // okay, maybe this code isn't good, but i can't find any other solution to update
-  // dll->tail pointer
-  dll_obj_t * restrict iobj = dll->head;
-  while (iobj) {
-    if (!iobj->next) {
+  for (bool more = NULL != it.__obj; more; more = dll_snapshot_next(&it)) {
+    __dlli_snapshot_sync(&it);
+    if (NULL == it.__obj) {
       break;
     }
-    iobj = iobj->next;
+    fn(it.__obj->data, any, it.__index);
   }
-  dll->tail = iobj;
 
   return true;
 }
 
-__dll_inline bool dll_is_equal(const dll_t * restrict const dll_a,
-                               const dll_t * restrict const dll_b,
-                               dll_callback_ext_fn_t fn_cmp,
-                               void * restrict any) {
+__dll_inline dll_snapshot_iterator_t
+    dll_snapshot_iterator(const dll_snapshot_t * restrict snap) {
+  dll_snapshot_iterator_t it = {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll_a || NULL == dll_b)) {
+      snap ? snap->head : NULL,
+#else
+      snap->head,
+#endif
+      snap,
+      0,
+#ifndef LIBDLL_UNSAFE_USAGE
+      snap ? !snap->__shared : true,
+#else
+      !snap->__shared,
+#endif
+  };
+
+  return it;
+}
+
+__dll_inline bool dll_snapshot_next(dll_snapshot_iterator_t * restrict it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || NULL == it->__obj)) {
     return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if (dll_a->objs_count != dll_b->objs_count) {
+  __dlli_snapshot_sync(it);
+  if (NULL == it->__obj || it->__snap->objs_count <= ++it->__index) {
+    it->__obj = NULL;
     return false;
   }
 
-  dll_obj_t * restrict iobj_a = dll_a->head;
-  dll_obj_t * restrict iobj_b = dll_b->head;
-  size_t i                    = 0;
-
-  for (; iobj_a && iobj_b; iobj_a = iobj_a->next, iobj_b = iobj_b->next) {
-    if (fn_cmp) {
-      if (0 != fn_cmp(iobj_a->data, iobj_b->data, any, i++)) {
-        return false;
-      }
-    } else {
-      if (iobj_a->size != iobj_b->size || iobj_a->data != iobj_b->data) {
-        return false;
-      }
-    }
-  }
+  it->__obj = it->__snap->__reversed ? it->__obj->prev : it->__obj->next;
 
-  return !(iobj_a || iobj_b);
+  return true;
 }
 
-__dll_inline bool dll_delete(dll_t * restrict dll, dll_obj_t * restrict obj) {
-  dll_obj_t * restrict del_obj = dll_unlink(dll, obj);
-
+__dll_inline void *
+    dll_snapshot_iterator_get_data(dll_snapshot_iterator_t * restrict it) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (NULL == del_obj) {
-    return false;
+  if (__dll_unlikely(NULL == it || NULL == it->__obj)) {
+    return NULL;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  const bool __ret = dll_free_obj(&del_obj);
+  __dlli_snapshot_sync(it);
 
-  return __ret;
+  return it->__obj ? it->__obj->data : NULL;
 }
 
-__dll_inline dll_obj_t * dll_unlink(dll_t * restrict dll, dll_obj_t * restrict obj) {
+__dll_inline bool dll_snapshot_free(dll_snapshot_t * restrict * restrict snap) {
 #ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == obj)) {
-    return NULL;
+  if (__dll_unlikely(NULL == snap || NULL == *snap)) {
+    return false;
   }
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-  if (obj->prev) {
-    obj->prev->next = obj->next;
-  } else {
-    dll->head = obj->next;
+  dll_snapshot_t * restrict self = *snap;
+
+  *snap = NULL;
+  if (--self->__refs) {
+    return true;
+  }
+
+  if (self->__older) {
+    self->__older->__newer = self->__newer;
+  }
+  if (self->__newer) {
+    self->__newer->__older = self->__older;
+  } else if (self->__dll) {
+    self->__dll->__snapshot = self->__older;
   }
 
-  if (obj->next) {
-    obj->next->prev = obj->prev;
+  // retired list-objects may be still seen through the other snapshots
+  dll_snapshot_t * restrict heir = self->__older ? self->__older : self->__newer;
+
+  if (self->__retired && heir) {
+    dll_obj_t * restrict last = self->__retired;
+
+    while (last->next) {
+      last = last->next;
+    }
+    __dlli_retire(heir, self->__retired, last);
   } else {
-    dll->tail = obj->prev;
+    __dlli_free_chain(self->__retired);
   }
 
-  obj->prev = NULL;
-  obj->next = NULL;
-  --dll->objs_count;
+  for (size_t i = 0; self->__segments && self->__segments[i]; ++i) {
+    __dlli_block_free(self->__segments[i]);
+  }
+  free(self->__segments);
+  free(self);
 
-  return obj;
+  return true;
 }
 
-__dll_inline bool dll_free_obj(dll_obj_t * restrict * restrict obj) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == obj || NULL == *obj)) {
+__dll_inline bool dll_stats_dump(const dll_t * restrict dll, FILE * restrict out) {
+#ifdef LIBDLL_STATS
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == out)) {
     return false;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  const dll_stats_t * restrict stats = &dll->stats;
+
+  const int __ret = fprintf(out,
+                            "dll %p: len=%zu max_len=%zu ops=%zu steps=%zu calls=%zu "
+                            "allocs=%zu frees=%zu cmps=%zu\n",
+                            (const void *)dll,
+                            dll->objs_count,
+                            stats->max_len,
+                            stats->ops,
+                            stats->steps,
+                            stats->calls,
+                            stats->allocs,
+                            stats->frees,
+                            stats->cmps);
+
+  return 0 < __ret;
+#else
+  (void)dll;
+  (void)out;
+  return false;
+#endif /* LIBDLL_STATS */
+}
 
-  if ((*obj)->destructor) {
-    if (LIBDLL_DESTRUCTOR_DEFAULT == (*obj)->destructor) {
-      free((*obj)->data);
-    } else {
-      (*obj)->destructor((*obj)->data);
+__dll_inline bool dll_stats_reset(dll_t * restrict dll) {
+#ifdef LIBDLL_STATS
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  memset(&dll->stats, 0, sizeof(dll->stats));
+  dll->stats.max_len = dll->objs_count;
+
+  return true;
+#else
+  (void)dll;
+  return false;
+#endif /* LIBDLL_STATS */
+}
+
+__dll_inline bool
+    dll_memory_usage(const dll_t * restrict dll, dll_memory_t * restrict stats) {
+#ifdef LIBDLL_MEMORY
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == stats)) {
+    return false;
+  }
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  const size_t block_objs = dll->__block_objs;
+  const size_t blocks     = dll->__blocks + dll->__foreign_objs;
+#  ifdef LIBDLL_SORTED
+  const size_t skip_bytes = dll->__skip_bytes;
+#  else
+  const size_t skip_bytes = 0;
+#  endif /* LIBDLL_SORTED */
+  // towers hold one link at least, so there are no more of them than this
+  const size_t towers = skip_bytes / (sizeof(dll_skip_t) + sizeof(dll_skip_t *));
+
+  stats->objs                 = dll->objs_count;
+  stats->obj_bytes            = dll->objs_count * sizeof(dll_obj_t);
+  stats->data_bytes           = dll->__data_bytes;
+  stats->block_objs           = block_objs;
+  stats->block_used_bytes     = block_objs * sizeof(dll_obj_t);
+  stats->block_reserved_bytes = blocks * LIBDLL_BLOCK_SIZE;
+  stats->skip_bytes           = skip_bytes;
+  stats->alloc_overhead_bytes =
+      (1 + dll->objs_count - block_objs + towers) * LIBDLL_MALLOC_OVERHEAD;
+  stats->total_bytes = sizeof(*dll) + stats->obj_bytes - stats->block_used_bytes +
+                       stats->block_reserved_bytes + stats->data_bytes +
+                       stats->skip_bytes + stats->alloc_overhead_bytes;
+
+  return true;
+#else
+  (void)dll;
+  (void)stats;
+  return false;
+#endif /* LIBDLL_MEMORY */
+}
+
+__dll_inline bool dll_fingerprint(dll_t * restrict dll, uint64_t * restrict out) {
+#ifdef LIBDLL_FINGERPRINT
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == out)) {
+    return false;
+  }
+#  endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (dll->__fp_stale) {
+    uint64_t fingerprint = 0;
+    uint64_t prev        = 0;
+
+    // the sum of links between neighbours and to both ends, without the empty list's one
+    for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+      const uint64_t self = iobj->__fp_hash = __dlli_fp_hash(iobj);
+
+      fingerprint += __dlli_fp_link_hash(prev, self);
+      prev = self;
     }
+    if (dll->head) {
+      fingerprint += __dlli_fp_link_hash(prev, 0) - __dlli_fp_link_hash(0, 0);
+    }
+
+    dll->__fingerprint = fingerprint;
+    dll->__fp_stale    = false;
   }
 
-  (*obj)->data = NULL;
-  free(*obj);
-  *obj = NULL;
+  *out = dll->__fingerprint;
   return true;
+#else
+  (void)dll;
+  (void)out;
+  return false;
+#endif /* LIBDLL_FINGERPRINT */
 }
 
-__dll_inline bool dll_free(dll_t * restrict * restrict dll) {
-#ifndef LIBDLL_UNSAFE_USAGE
-  if (__dll_unlikely(NULL == dll || NULL == *dll)) {
+__dll_inline bool dll_fingerprint_invalidate(dll_t * restrict dll) {
+#ifdef LIBDLL_FINGERPRINT
+#  ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
     return false;
   }
-#endif /* LIBDLL_UNSAFE_USAGE */
+#  endif /* LIBDLL_UNSAFE_USAGE */
 
-  dll_obj_t * restrict iobj = (*dll)->head;
-  dll_obj_t * restrict save = NULL;
+  dll->__fp_stale = true;
+  return true;
+#else
+  (void)dll;
+  return false;
+#endif /* LIBDLL_FINGERPRINT */
+}
 
-  while (iobj) {
-    save = iobj->next;
+//
+// ----------------------------
+// Typed lists generation
+// ----------------------------
+//
 
 #ifndef LIBDLL_UNSAFE_USAGE
-    if (false == dll_free_obj(&iobj)) {
-      return false;
+/**
+ * Returns \p _ret from the enclosing function if \p _cond is met, the same as the
+ * #LIBDLL_UNSAFE_USAGE guarded checks, for functions defined by macros.
+ */
+#  define __dlli_check(_cond, _ret)                                                      \
+    if (__dll_unlikely(_cond)) {                                                         \
+      return _ret;                                                                       \
     }
 #else
-    dll_free_obj(&iobj)
+#  define __dlli_check(_cond, _ret)
 #endif /* LIBDLL_UNSAFE_USAGE */
 
-    iobj = save;
+/**
+ * \b Defines type-specialized functions for lists which data is of \p _T type, with the
+ * comparing expression \p _cmp inlined instead of calling a callback-function.
+ *
+ * \p _cmp compares two data pointers available as \c a and \c b of <tt>_T *</tt> type and
+ * results the same as a #dll_callback_ext_fn_t would. For example:
+ * \code
+ * DLL_DEFINE_TYPED(dll_int, int, (*a > *b) - (*a < *b))
+ * \endcode
+ * defines for an \c int list:
+ * - \c dll_int_emplace_front and \c dll_int_emplace_back : typed #dll_emplace_front and
+ * #dll_emplace_back , which take \c sizeof(_T) as data size.
+ * - \c dll_int_sort : #dll_sort .
+ * - \c dll_int_find : #dll_find of the first data equal to the given \c key .
+ * - \c dll_int_remove : #dll_remove of all data equal to the given \c key .
+ * - \c dll_int_unique : #dll_unique .
+ * - \c dll_int_is_equal : #dll_is_equal .
+ *
+ * All of them work on ordinary #dll_t lists, so they can be mixed with the generic API.
+ */
+#define DLL_DEFINE_TYPED(_name, _T, _cmp)                                                \
+  __DLLI_DEFINE_MSORT(__dlli_msort_##_name, _T, _cmp)                                    \
+                                                                                         \
+  __dll_inline ssize_t __dlli_cmp_##_name(_T * a, _T * b) { return (ssize_t)(_cmp); }    \
+                                                                                         \
+  __dll_inline dll_obj_t * _name##_emplace_front(                                        \
+      dll_t * dll, _T * data, dll_callback_destructor_fn_t destructor) {                 \
+    dll_obj_t * __ret = dll_emplace_front(dll, data, sizeof(_T), destructor);            \
+                                                                                         \
+    return __ret;                                                                        \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline dll_obj_t * _name##_emplace_back(                                         \
+      dll_t * dll, _T * data, dll_callback_destructor_fn_t destructor) {                 \
+    dll_obj_t * __ret = dll_emplace_back(dll, data, sizeof(_T), destructor);             \
+                                                                                         \
+    return __ret;                                                                        \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline bool _name##_sort(dll_t * dll) {                                          \
+    __dlli_check(NULL == dll, false)                                                     \
+    if (1 >= dll->objs_count) {                                                          \
+      return true;                                                                       \
+    }                                                                                    \
+                                                                                         \
+    dll_obj_t * tail = NULL;                                                             \
+                                                                                         \
+    if (__dll_unlikely(!__dlli_normalize(dll))) {                                        \
+      return false;                                                                      \
+    }                                                                                    \
+    __dlli_stat(dll, ops, 1);                                                            \
+    __dlli_skip_drop(dll);                                                               \
+    __dlli_fp_stale(dll);                                                                \
+    dll->head = __dlli_msort_##_name(dll->head, &tail, NULL, NULL);                      \
+    dll->tail = tail;                                                                    \
+    return true;                                                                         \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline _T * _name##_find(const dll_t * dll, _T * key) {                          \
+    __dlli_check(NULL == dll, NULL)                                                      \
+                                                                                         \
+    for (dll_obj_t * iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {            \
+      if (0 == __dlli_cmp_##_name((_T *)iobj->data, key)) {                              \
+        return (_T *)iobj->data;                                                         \
+      }                                                                                  \
+    }                                                                                    \
+                                                                                         \
+    return NULL;                                                                         \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline size_t _name##_remove(dll_t * dll, _T * key) {                            \
+    size_t removed_objs = 0;                                                             \
+                                                                                         \
+    __dlli_check(NULL == dll, 0)                                                         \
+                                                                                         \
+    for (dll_obj_t * iobj = dll->head; iobj;) {                                          \
+      dll_obj_t * save = __dlli_next(dll, iobj);                                         \
+                                                                                         \
+      if (0 == __dlli_cmp_##_name((_T *)iobj->data, key) && dll_delete(dll, iobj)) {     \
+        ++removed_objs;                                                                  \
+      }                                                                                  \
+      iobj = save;                                                                       \
+    }                                                                                    \
+                                                                                         \
+    return removed_objs;                                                                 \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline size_t _name##_unique(dll_t * dll) {                                      \
+    size_t removed_objs = 0;                                                             \
+                                                                                         \
+    __dlli_check(NULL == dll, 0)                                                         \
+                                                                                         \
+    for (dll_obj_t * iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {            \
+      for (dll_obj_t * jobj = __dlli_next(dll, iobj); jobj;) {                           \
+        dll_obj_t * save = __dlli_next(dll, jobj);                                       \
+                                                                                         \
+        if (0 == __dlli_cmp_##_name((_T *)iobj->data, (_T *)jobj->data) &&               \
+            dll_delete(dll, jobj)) {                                                     \
+          ++removed_objs;                                                                \
+        }                                                                                \
+        jobj = save;                                                                     \
+      }                                                                                  \
+    }                                                                                    \
+                                                                                         \
+    return removed_objs;                                                                 \
+  }                                                                                      \
+                                                                                         \
+  __dll_inline bool _name##_is_equal(const dll_t * dll_a,                                \
+                                     const dll_t * dll_b) {                              \
+    __dlli_check(NULL == dll_a || NULL == dll_b, false)                                  \
+    if (dll_a->objs_count != dll_b->objs_count) {                                        \
+      return false;                                                                      \
+    }                                                                                    \
+                                                                                         \
+    dll_obj_t * iobj_a = dll_a->head;                                                    \
+    dll_obj_t * iobj_b = dll_b->head;                                                    \
+                                                                                         \
+    for (; iobj_a && iobj_b;                                                             \
+         iobj_a = __dlli_next(dll_a, iobj_a), iobj_b = __dlli_next(dll_b, iobj_b)) {     \
+      if (0 != __dlli_cmp_##_name((_T *)iobj_a->data, (_T *)iobj_b->data)) {             \
+        return false;                                                                    \
+      }                                                                                  \
+    }                                                                                    \
+                                                                                         \
+    return !(iobj_a || iobj_b);                                                          \
   }
 
-  free(*dll);
-  *dll = NULL;
-
-  return true;
+#ifdef __cplusplus
 }
+#  undef restrict
+#endif /* __cplusplus */
 
 #endif /* LIBDLL_H */
@@ -0,0 +1,426 @@
+/**
+ * \file libdll.hpp
+ *
+ * \brief C++ wrapper over libdll.h: an owning list of \c T values with iterators usable
+ * by <algorithm> and comparators inlined at compile time.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLL_HPP
+#define LIBDLL_HPP
+
+#if __cplusplus < 201402L
+#  error "libdll.hpp requires C++14"
+#endif
+
+#include "libdll.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#  if __has_include(<execution>)
+#    include <algorithm>
+#    include <execution>
+#  endif
+#endif
+
+namespace libdll {
+
+namespace detail {
+
+/**
+ * \b Destructor for list-objects data allocated by #libdll::list .
+ */
+template <typename T> void destroy(void * data) { delete static_cast<T *>(data); }
+
+/**
+ * \b \c true for execution policies, which pick the parallel #libdll::list::sort .
+ */
+#ifdef __cpp_lib_execution
+template <typename P>
+constexpr bool is_policy = std::is_execution_policy<std::decay_t<P>>::value;
+#else
+template <typename P> constexpr bool is_policy = false;
+#endif /* __cpp_lib_execution */
+
+/**
+ * \b Stamps out the same iterative merge sort #dll_sort uses, with a \c Less
+ * comparator inlined instead of a callback-function. \c any points to the comparator.
+ */
+template <typename T, typename Less> struct msort {
+  __DLLI_DEFINE_MSORT(run, T, (*static_cast<Less *>(any))(*b, *a) ? 1 : 0)
+};
+
+} // namespace detail
+
+/**
+ * \b Owning list of \c T values, stored as data of #dll_obj_t list-objects.
+ *
+ * Values are allocated with \c new and freed by the list-objects destructors, so the list
+ * may be passed to and taken from C code as a #dll_t with #get , #release and the
+ * adopting constructor.
+ */
+template <typename T> class list {
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = T &;
+  using const_reference = const T &;
+  using pointer         = T *;
+  using const_pointer   = const T *;
+
+  /**
+   * \b Bidirectional iterator over list-objects of a list, following its direction set
+   * by #dll_reverse . The past-the-end iterator holds no list-object.
+   */
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<Const, const T *, T *>;
+    using reference         = std::conditional_t<Const, const T &, T &>;
+
+    basic_iterator() noexcept = default;
+    basic_iterator(const dll_t * dll, dll_obj_t * obj) noexcept : dll_(dll), obj_(obj) {}
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false> & other) noexcept
+        : dll_(other.dll_), obj_(other.obj_) {}
+
+    reference operator*() const noexcept { return *static_cast<pointer>(obj_->data); }
+    pointer   operator->() const noexcept { return static_cast<pointer>(obj_->data); }
+
+    basic_iterator & operator++() noexcept {
+      obj_ = __dlli_next(dll_, obj_);
+      return *this;
+    }
+    basic_iterator operator++(int) noexcept {
+      basic_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+    basic_iterator & operator--() noexcept {
+      obj_ = obj_ ? __dlli_prev(dll_, obj_) : dll_->tail;
+      return *this;
+    }
+    basic_iterator operator--(int) noexcept {
+      basic_iterator ret = *this;
+      --*this;
+      return ret;
+    }
+
+    friend bool operator==(const basic_iterator & a, const basic_iterator & b) noexcept {
+      return a.obj_ == b.obj_;
+    }
+    friend bool operator!=(const basic_iterator & a, const basic_iterator & b) noexcept {
+      return a.obj_ != b.obj_;
+    }
+
+    /** list-object the iterator points to, NULL for the past-the-end iterator. */
+    dll_obj_t * obj() const noexcept { return obj_; }
+
+  private:
+    friend class list;
+    friend class basic_iterator<!Const>;
+
+    const dll_t * dll_ = nullptr;
+    dll_obj_t *   obj_ = nullptr;
+  };
+
+  using iterator       = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  list() : dll_(dll_new()) {
+    if (nullptr == dll_) {
+      throw std::bad_alloc();
+    }
+  }
+
+  /**
+   * \b Takes ownership of \p dll , which data must be \c T values allocated with \c new
+   * and list-objects destructors freeing them, or #LIBDLL_DESTRUCTOR_NULL for values
+   * owned elsewhere. Throws \c std::invalid_argument for \c nullptr .
+   */
+  explicit list(dll_t * dll) : dll_(dll) {
+    if (nullptr == dll_) {
+      throw std::invalid_argument("libdll::list: adopting a null dll_t");
+    }
+  }
+
+  list(const list &)             = delete;
+  list & operator=(const list &) = delete;
+
+  list(list && other) noexcept : dll_(std::exchange(other.dll_, nullptr)) {}
+  list & operator=(list && other) noexcept {
+    if (this != &other) {
+      if (dll_) {
+        dll_free(&dll_);
+      }
+      dll_ = std::exchange(other.dll_, nullptr);
+    }
+    return *this;
+  }
+
+  ~list() {
+    if (dll_) {
+      dll_free(&dll_);
+    }
+  }
+
+  /** underlying list, still owned by this object. */
+  dll_t * get() const noexcept { return dll_; }
+
+  /** \b Gives up ownership of the underlying list, leaving this object empty-handed. */
+  dll_t * release() noexcept { return std::exchange(dll_, nullptr); }
+
+  iterator       begin() noexcept { return iterator(dll_, dll_->head); }
+  iterator       end() noexcept { return iterator(dll_, nullptr); }
+  const_iterator begin() const noexcept { return const_iterator(dll_, dll_->head); }
+  const_iterator end() const noexcept { return const_iterator(dll_, nullptr); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  size_type size() const noexcept { return dll_->objs_count; }
+  bool      empty() const noexcept { return 0 == dll_->objs_count; }
+
+  reference       front() noexcept { return *begin(); }
+  const_reference front() const noexcept { return *begin(); }
+  reference       back() noexcept { return *static_cast<T *>(dll_->tail->data); }
+  const_reference back() const noexcept { return *static_cast<T *>(dll_->tail->data); }
+
+  template <typename... Args> reference emplace_back(Args &&... args) {
+    return link_obj(dll_push_back, make_obj(std::forward<Args>(args)...));
+  }
+  template <typename... Args> reference emplace_front(Args &&... args) {
+    return link_obj(dll_push_front, make_obj(std::forward<Args>(args)...));
+  }
+  void push_back(const T & value) { emplace_back(value); }
+  void push_back(T && value) { emplace_back(std::move(value)); }
+  void push_front(const T & value) { emplace_front(value); }
+  void push_front(T && value) { emplace_front(std::move(value)); }
+
+  void pop_front() noexcept { dll_delete(dll_, dll_->head); }
+  void pop_back() noexcept { dll_delete(dll_, dll_->tail); }
+
+  /** \b Deletes list-object at \p pos , returning an iterator to the one after it. */
+  iterator erase(const_iterator pos) noexcept {
+    dll_obj_t * next = __dlli_next(dll_, pos.obj_);
+
+    dll_delete(dll_, pos.obj_);
+    return iterator(dll_, next);
+  }
+
+  void clear() noexcept { dll_clear(dll_); }
+
+  /** \b Reverses the list in O(1), see #dll_reverse . */
+  void reverse() noexcept { dll_reverse(dll_); }
+
+  /**
+   * \b Stable sort with the \p less comparator inlined into the merge sort of #dll_sort .
+   */
+  template <typename Less = std::less<T>,
+            typename      = std::enable_if_t<!detail::is_policy<Less>>>
+  void sort(Less less = Less()) {
+    if (1 >= dll_->objs_count) {
+      return;
+    }
+
+    dll_obj_t * tail = nullptr;
+
+    if (!__dlli_normalize(dll_)) {
+      throw std::bad_alloc();
+    }
+    __dlli_stat(dll_, ops, 1);
+    __dlli_skip_drop(dll_);
+    __dlli_fp_stale(dll_);
+    dll_->head = detail::msort<T, Less>::run(dll_->head, &tail, nullptr, &less);
+    dll_->tail = tail;
+  }
+
+  template <typename Pred> iterator find_if(Pred pred) {
+    for (dll_obj_t * iobj = dll_->head; iobj; iobj = __dlli_next(dll_, iobj)) {
+      if (pred(*static_cast<T *>(iobj->data))) {
+        return iterator(dll_, iobj);
+      }
+    }
+    return end();
+  }
+
+  iterator find(const T & value) {
+    return find_if([&value](const T & v) { return v == value; });
+  }
+
+  /** \b Deletes all the values matching \p pred , returning count of deleted ones. */
+  template <typename Pred> size_type remove_if(Pred pred) {
+    size_type removed_objs = 0;
+
+    for (dll_obj_t * iobj = dll_->head; iobj;) {
+      dll_obj_t * save = __dlli_next(dll_, iobj);
+
+      if (pred(*static_cast<T *>(iobj->data)) && dll_delete(dll_, iobj)) {
+        ++removed_objs;
+      }
+      iobj = save;
+    }
+    return removed_objs;
+  }
+
+  size_type remove(const T & value) {
+    return remove_if([&value](const T & v) { return v == value; });
+  }
+
+  /**
+   * \b Deletes all but the first value of every run of consecutive values equal by \p eq
+   * , as \c std::list::unique does. Unlike #dll_unique , which removes equal values
+   * throughout the list.
+   */
+  template <typename Eq = std::equal_to<T>> size_type unique(Eq eq = Eq()) {
+    size_type removed_objs = 0;
+
+    if (nullptr == dll_->head) {
+      return 0;
+    }
+
+    dll_obj_t * kept = dll_->head;
+    for (dll_obj_t * iobj = __dlli_next(dll_, kept); iobj;) {
+      dll_obj_t * save = __dlli_next(dll_, iobj);
+
+      if (eq(*static_cast<T *>(kept->data), *static_cast<T *>(iobj->data))) {
+        removed_objs += dll_delete(dll_, iobj);
+      } else {
+        kept = iobj;
+      }
+      iobj = save;
+    }
+    return removed_objs;
+  }
+
+  /**
+   * \b Flattens the list into a vector of pointers to its values, in list order. The
+   * vector stays valid until list-objects are deleted.
+   */
+  std::vector<T *> flatten() const {
+    std::vector<T *> ret;
+
+    ret.reserve(dll_->objs_count);
+    for (dll_obj_t * iobj = dll_->head; iobj; iobj = __dlli_next(dll_, iobj)) {
+      ret.push_back(static_cast<T *>(iobj->data));
+    }
+    return ret;
+  }
+
+#ifdef __cpp_lib_execution
+  /**
+   * \b Runs \p fn over all the values with \p policy , on a flattened view of the list.
+   */
+  template <typename Policy,
+            typename Fn,
+            typename = std::enable_if_t<
+                std::is_execution_policy_v<std::remove_cv_t<std::remove_reference_t<Policy>>>>>
+  void for_each(Policy && policy, Fn fn) {
+    std::vector<T *> view = flatten();
+
+    std::for_each(std::forward<Policy>(policy), view.begin(), view.end(), [&fn](T * v) {
+      fn(*v);
+    });
+  }
+
+  /**
+   * \b Sorts list-objects with \p policy on a flattened view of the list, then relinks
+   * them in the sorted order in one pass. Stable, as #sort .
+   */
+  template <typename Policy,
+            typename Less = std::less<T>,
+            typename      = std::enable_if_t<
+                std::is_execution_policy_v<std::remove_cv_t<std::remove_reference_t<Policy>>>>>
+  void sort(Policy && policy, Less less = Less()) {
+    if (1 >= dll_->objs_count) {
+      return;
+    }
+
+    std::vector<dll_obj_t *> objs;
+
+    objs.reserve(dll_->objs_count);
+    for (dll_obj_t * iobj = dll_->head; iobj; iobj = __dlli_next(dll_, iobj)) {
+      objs.push_back(iobj);
+    }
+
+    std::stable_sort(std::forward<Policy>(policy),
+                     objs.begin(),
+                     objs.end(),
+                     [&less](const dll_obj_t * a, const dll_obj_t * b) {
+                       return less(*static_cast<const T *>(a->data),
+                                   *static_cast<const T *>(b->data));
+                     });
+
+    if (!__dlli_cow(dll_)) {
+      throw std::bad_alloc();
+    }
+    __dlli_stat(dll_, ops, 1);
+    __dlli_skip_drop(dll_);
+    __dlli_fp_stale(dll_);
+
+    dll_obj_t * prev = nullptr;
+    for (dll_obj_t * iobj : objs) {
+      iobj->prev = prev;
+      if (prev) {
+        prev->next = iobj;
+      }
+      prev = iobj;
+    }
+    prev->next       = nullptr;
+    dll_->head       = objs.front();
+    dll_->tail       = prev;
+    dll_->__reversed = false;
+  }
+#endif /* __cpp_lib_execution */
+
+private:
+  template <typename... Args> dll_obj_t * make_obj(Args &&... args) {
+    T *         data = new T(std::forward<Args>(args)...);
+    dll_obj_t * obj  = dll_new_obj(data, sizeof(T), &detail::destroy<T>);
+
+    if (nullptr == obj) {
+      delete data;
+      throw std::bad_alloc();
+    }
+    return obj;
+  }
+
+  /** \b Links \p obj with \p push , destroying it if that fails. */
+  reference link_obj(dll_obj_t * (*push)(dll_t *, dll_obj_t *), dll_obj_t * obj) {
+    if (nullptr == push(dll_, obj)) {
+      dll_free_obj(&obj);
+      throw std::bad_alloc();
+    }
+    return *static_cast<T *>(obj->data);
+  }
+
+  dll_t * dll_;
+};
+
+} // namespace libdll
+
+#endif /* LIBDLL_HPP */
@@ -0,0 +1,929 @@
+/**
+ * \file libdll32.h
+ *
+ * \brief Compact variant of libdll lists: list-objects live in one growable slab and are
+ * linked by 32-bit indices instead of pointers.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLL32_H
+#define LIBDLL32_H
+
+#include "libdll.h"
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// libdll32 specifications and macroses
+// ----------------------------
+//
+
+#ifdef LIBDLL32_OBJ_SIZE
+#  undef LIBDLL32_OBJ_SIZE
+
+/**
+ * Keeps a \c size of data in every #dll32_obj_t list-object. Without it list-objects
+ * take 16 bytes on 64-bit targets and \c size arguments are ignored.
+ */
+#  define LIBDLL32_OBJ_SIZE 1
+
+#endif /* LIBDLL32_OBJ_SIZE */
+
+/**
+ * An index which refers to no list-object, like \c NULL for #dll_obj_t pointers.
+ */
+#define LIBDLL32_NIL ((dll32_idx_t)UINT32_MAX)
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * An index of a list-object inside of its list slab.
+ *
+ * \typedef dll32_idx_t
+ */
+typedef uint32_t dll32_idx_t;
+
+/**
+ * A compact list-object structure.
+ *
+ * \typedef dll32_obj_t
+ */
+typedef struct {
+  /** an index of next list-object. */
+  dll32_idx_t next;
+  /** an index of previous list-object. */
+  dll32_idx_t prev;
+  /** an any user defined data. */
+  void * restrict data;
+
+#ifdef LIBDLL32_OBJ_SIZE
+  /** a \c data size. */
+  size_t size;
+#endif /* LIBDLL32_OBJ_SIZE */
+} dll32_obj_t;
+
+/**
+ * A compact doubly linked list structure.
+ *
+ * \note All the list-objects are stored in the \c objs slab, which moves when it grows,
+ * so list-objects are referred by their #dll32_idx_t index and never by pointers.
+ *
+ * \typedef dll32_t
+ */
+typedef struct {
+  /** a slab of all the list-objects, linked and free ones. */
+  dll32_obj_t * restrict objs;
+  /** a count of list-objects slab can hold. */
+  dll32_idx_t capacity;
+  /** a count of slab list-objects handed out at least once. */
+  dll32_idx_t used;
+  /** free list-objects of the slab, linked through \c next . */
+  dll32_idx_t free_head;
+  /** a head of list. */
+  dll32_idx_t head;
+  /** a tail of list. */
+  dll32_idx_t tail;
+  /** a counter of list-objects in list. */
+  size_t objs_count;
+
+  /**
+   * \destructor_description
+   *
+   * \note One destructor is shared by all the list-objects of the list.
+   */
+  dll_callback_destructor_fn_t destructor;
+} dll32_t;
+
+/**
+ * A compact list-object iterator structure.
+ *
+ * \typedef dll32_iterator_t
+ */
+typedef struct {
+  /** a current iterator list-object */
+  dll32_idx_t __obj;
+  /** an original list, for which iterator was created */
+  dll32_t * restrict __dll;
+  /** current list-object index. */
+  size_t __index;
+} dll32_iterator_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Creates a new and empty compact list with this function.
+ *
+ * \param destructor \destructor_description
+ *
+ * \return allocated memory for new list, \c NULL otherwise
+ */
+__dll_inline dll32_t * dll32_new(dll_callback_destructor_fn_t destructor);
+
+/**
+ * \b Creates a new list-object in the slab of \p dll , not linked to the list yet.
+ *
+ * \param dll list which slab will hold the list-object.
+ * \param data any data you want to put inside of list.
+ * \param size a size of \p data , ignored without #LIBDLL32_OBJ_SIZE .
+ *
+ * \return index of a new list-object, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_new_obj(dll32_t * restrict dll,
+                                       void * restrict data,
+                                       size_t size);
+
+/**
+ * \b Pushes a list-object \p obj to front of given \p dll list.
+ *
+ * \param dll destination list.
+ * \param obj index of unlinked list-object from the slab of \p dll .
+ *
+ * \return \p obj on success, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_push_front(dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * \b Pushes a list-object \p obj to end of given \p dll list.
+ *
+ * \param dll destination list.
+ * \param obj index of unlinked list-object from the slab of \p dll .
+ *
+ * \return \p obj on success, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_push_back(dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * \b Creates a new list-object via #dll32_new_obj and pushes it in front of \p dll list.
+ *
+ * \param dll destination list.
+ * \param data any data.
+ * \param size size of \p data.
+ *
+ * \return index of a new list-object, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_emplace_front(dll32_t * restrict dll,
+                                             void * restrict data,
+                                             size_t size);
+
+/**
+ * \b Creates a new list-object via #dll32_new_obj and pushes it at the end of \p dll list.
+ *
+ * \param dll destination list.
+ * \param data any data.
+ * \param size size of \p data.
+ *
+ * \return index of a new list-object, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_emplace_back(dll32_t * restrict dll,
+                                            void * restrict data,
+                                            size_t size);
+
+/**
+ * \b Unlinks the first(head) list-object from the list.
+ *
+ * \param dll list.
+ *
+ * \return index of unlinked list-object, #LIBDLL32_NIL if list is empty.
+ */
+__dll_inline dll32_idx_t dll32_pop_front(dll32_t * restrict dll);
+
+/**
+ * \b Unlinks the last(tail) list-object from the list.
+ *
+ * \param dll list.
+ *
+ * \return index of unlinked list-object, #LIBDLL32_NIL if list is empty.
+ */
+__dll_inline dll32_idx_t dll32_pop_back(dll32_t * restrict dll);
+
+/**
+ * \b Inserts a list-object \p obj on the specified location \p pos in the list \p dll .
+ *
+ * \note \p pos must starts from 0 to #dll32_size .
+ *
+ * \param dll list.
+ * \param obj index of unlinked list-object from the slab of \p dll .
+ * \param pos injection position where list-object will be inserted.
+ *
+ * \return \p obj on success, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_insert(dll32_t * restrict dll, dll32_idx_t obj, size_t pos);
+
+/**
+ * \b Inserts a new list-object created via #dll32_new_obj on the specified location
+ * \p pos in the list \p dll .
+ *
+ * \param dll list.
+ * \param data any data.
+ * \param size size of \p data.
+ * \param pos injection position where list-object will be inserted.
+ *
+ * \return index of inserted list-object, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t
+    dll32_emplace(dll32_t * restrict dll, void * restrict data, size_t size, size_t pos);
+
+/**
+ * \b Unlink (only removes list-object from list but not deleting it) a list-object
+ * \p obj from list \p dll .
+ *
+ * \param dll list.
+ * \param obj index of list-object to be unlinked.
+ *
+ * \return \p obj on success, #LIBDLL32_NIL otherwise
+ */
+__dll_inline dll32_idx_t dll32_unlink(dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * \b Returns an unlinked list-object \p obj back to the slab of \p dll , calling the list
+ * \c destructor for its \c data .
+ *
+ * \param dll list which slab holds \p obj .
+ * \param obj index of unlinked list-object.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll32_free_obj(dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * **Unlink and free** a list-object \p obj from list \p dll .
+ *
+ * \param dll list.
+ * \param obj index of list-object to be deleted.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll32_delete(dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * \b Erases all elements from the \p dll list, keeping the slab memory for reuse.
+ *
+ * \param dll list.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll32_clear(dll32_t * restrict dll);
+
+/**
+ * \b Free the whole list with its slab and data of all list-objects.
+ *
+ * \param dll list.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll32_free(dll32_t * restrict * restrict dll);
+
+/**
+ * \b Going throught all the list-objects in \p dll list and calls a provided \p fn
+ * callback-function for each list-object.
+ *
+ * \param dll list.
+ * \param fn callback for data of each list-object.
+ * \param any any data to be passed to the \p fn second argument.
+ *
+ * \return \c true on success, \c false otherwise.
+ */
+__dll_inline bool
+    dll32_foreach(const dll32_t * restrict dll, dll_callback_fn_t fn, void * restrict any);
+
+/**
+ * \b Searches for specific \p data via \p fn_search when it returns zero value.
+ *
+ * \param dll list.
+ * \param fn_search function which will deside is given \c data is valid
+ * \param any an any additional data that will be passed to the second argument of
+ * \p fn_search
+ *
+ * \return index of first occurrence of searched data in list \p dll , #LIBDLL32_NIL
+ * otherwise.
+ */
+__dll_inline dll32_idx_t dll32_find(const dll32_t * restrict dll,
+                                    dll_callback_fn_t fn_search,
+                                    void * restrict any);
+
+/**
+ * \b Creates a new #dll32_iterator_t iterator at the first list-object of \p dll list.
+ *
+ * \param dll list.
+ *
+ * \return a new iterator
+ */
+__dll_inline dll32_iterator_t dll32_front(dll32_t * restrict dll);
+
+/**
+ * \b Creates a new #dll32_iterator_t iterator at the last list-object of \p dll list.
+ *
+ * \param dll list.
+ *
+ * \return a new iterator
+ */
+__dll_inline dll32_iterator_t dll32_back(dll32_t * restrict dll);
+
+/**
+ * \b Moves the #dll32_iterator_t to next list-object.
+ *
+ * \return true while not meets the end of list.
+ */
+__dll_inline bool dll32_next(dll32_iterator_t * restrict const it);
+
+/**
+ * \b Moves the #dll32_iterator_t to previous list-object.
+ *
+ * \return true while not meets a start of list.
+ */
+__dll_inline bool dll32_prev(dll32_iterator_t * restrict const it);
+
+/**
+ * \b Access index of the list-object at the iterator \p it .
+ *
+ * \param it an iterator.
+ *
+ * \return list-object index, #LIBDLL32_NIL at the end or at the start of list.
+ */
+__dll_inline dll32_idx_t dll32_iterator_get_obj(const dll32_iterator_t * restrict const it);
+
+/**
+ * \b Access data of the list-object at the iterator \p it .
+ *
+ * \param it an iterator.
+ *
+ * \return any data, \c NULL at the end or at the start of list.
+ */
+__dll_inline void * dll32_iterator_get_data(const dll32_iterator_t * restrict const it);
+
+/**
+ * \b Access current index of iterator \p it in the order of list.
+ *
+ * \param it an iterator.
+ *
+ * \return unsigned integer represents current iterator index
+ */
+__dll_inline size_t dll32_iterator_get_index(const dll32_iterator_t * restrict const it);
+
+/**
+ * \b Get the data inside list-object \p obj of the \p dll list.
+ *
+ * \param dll list.
+ * \param obj list-object index.
+ *
+ * \return any data.
+ */
+__dll_inline void * dll32_obj_get_data(const dll32_t * restrict dll, dll32_idx_t obj);
+
+/**
+ * \b Checks whether the list \p dll is empty or not.
+ *
+ * \param dll list.
+ *
+ * \return \c true if the list is empty, \c false otherwise.
+ */
+__dll_inline bool dll32_empty(const dll32_t * restrict dll);
+
+/**
+ * \b Get the count of elements in the provided list \p dll.
+ *
+ * \param dll list.
+ *
+ * \return count of elements in the list.
+ */
+__dll_inline size_t dll32_size(const dll32_t * restrict dll);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+__dll_inline dll32_t * dll32_new(dll_callback_destructor_fn_t destructor) {
+  dll32_t * restrict out = (dll32_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->free_head  = LIBDLL32_NIL;
+  out->head       = LIBDLL32_NIL;
+  out->tail       = LIBDLL32_NIL;
+  out->destructor = destructor;
+  return out;
+}
+
+/**
+ * \b Grows the slab of \p dll twice, up to #LIBDLL32_NIL list-objects.
+ *
+ * \param dll list.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool __dll32i_grow(dll32_t * restrict dll) {
+  if (LIBDLL32_NIL == dll->capacity) {
+    return false;
+  }
+
+  size_t capacity = dll->capacity ? (size_t)dll->capacity * 2 : 64;
+
+  if (LIBDLL32_NIL < capacity) {
+    capacity = LIBDLL32_NIL;
+  }
+
+  dll32_obj_t * restrict objs = (dll32_obj_t *)realloc(dll->objs, capacity * sizeof(*objs));
+
+  if (__dll_unlikely(NULL == objs)) {
+    return false;
+  }
+
+  dll->objs     = objs;
+  dll->capacity = (dll32_idx_t)capacity;
+  return true;
+}
+
+__dll_inline dll32_idx_t dll32_new_obj(dll32_t * restrict dll,
+                                       void * restrict data,
+                                       size_t size) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll32_idx_t out = dll->free_head;
+
+  if (LIBDLL32_NIL != out) {
+    dll->free_head = dll->objs[out].next;
+  } else {
+    if (dll->used == dll->capacity && !__dll32i_grow(dll)) {
+      return LIBDLL32_NIL;
+    }
+    out = dll->used++;
+  }
+
+  dll32_obj_t * restrict obj = &dll->objs[out];
+
+  obj->next = LIBDLL32_NIL;
+  obj->prev = LIBDLL32_NIL;
+  obj->data = data;
+#ifdef LIBDLL32_OBJ_SIZE
+  obj->size = size;
+#else
+  (void)size;
+#endif /* LIBDLL32_OBJ_SIZE */
+
+  return out;
+}
+
+__dll_inline dll32_idx_t dll32_push_front(dll32_t * restrict dll, dll32_idx_t obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll32_obj_t * restrict objs = dll->objs;
+
+  objs[obj].prev = LIBDLL32_NIL;
+  objs[obj].next = dll->head;
+
+  ++dll->objs_count;
+  if (LIBDLL32_NIL == dll->head) {
+    dll->tail = obj;
+  } else {
+    objs[dll->head].prev = obj;
+  }
+  dll->head = obj;
+
+  return obj;
+}
+
+__dll_inline dll32_idx_t dll32_push_back(dll32_t * restrict dll, dll32_idx_t obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll32_obj_t * restrict objs = dll->objs;
+
+  objs[obj].next = LIBDLL32_NIL;
+  objs[obj].prev = dll->tail;
+
+  ++dll->objs_count;
+  if (LIBDLL32_NIL == dll->tail) {
+    dll->head = obj;
+  } else {
+    objs[dll->tail].next = obj;
+  }
+  dll->tail = obj;
+
+  return obj;
+}
+
+__dll_inline dll32_idx_t dll32_emplace_front(dll32_t * restrict dll,
+                                             void * restrict data,
+                                             size_t size) {
+  const dll32_idx_t new_obj = dll32_new_obj(dll, data, size);
+  const dll32_idx_t __ret   = dll32_push_front(dll, new_obj);
+
+  return __ret;
+}
+
+__dll_inline dll32_idx_t dll32_emplace_back(dll32_t * restrict dll,
+                                            void * restrict data,
+                                            size_t size) {
+  const dll32_idx_t new_obj = dll32_new_obj(dll, data, size);
+  const dll32_idx_t __ret   = dll32_push_back(dll, new_obj);
+
+  return __ret;
+}
+
+__dll_inline dll32_idx_t dll32_pop_front(dll32_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (LIBDLL32_NIL == dll->head) {
+    return LIBDLL32_NIL;
+  }
+
+  const dll32_idx_t __ret = dll32_unlink(dll, dll->head);
+
+  return __ret;
+}
+
+__dll_inline dll32_idx_t dll32_pop_back(dll32_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (LIBDLL32_NIL == dll->tail) {
+    return LIBDLL32_NIL;
+  }
+
+  const dll32_idx_t __ret = dll32_unlink(dll, dll->tail);
+
+  return __ret;
+}
+
+__dll_inline dll32_idx_t dll32_insert(dll32_t * restrict dll, dll32_idx_t obj, size_t pos) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (dll->objs_count < pos) {
+    return LIBDLL32_NIL;
+  }
+  if (0 == pos) {
+    const dll32_idx_t __ret = dll32_push_front(dll, obj);
+
+    return __ret;
+  }
+  if (dll->objs_count == pos) {
+    const dll32_idx_t __ret = dll32_push_back(dll, obj);
+
+    return __ret;
+  }
+
+  dll32_obj_t * restrict objs = dll->objs;
+  dll32_idx_t            iter = dll->head;
+
+  for (size_t i = 1; pos > i; ++i) {
+    iter = objs[iter].next;
+  }
+
+  objs[obj].prev             = iter;
+  objs[obj].next             = objs[iter].next;
+  objs[objs[iter].next].prev = obj;
+  objs[iter].next            = obj;
+
+  ++dll->objs_count;
+
+  return obj;
+}
+
+__dll_inline dll32_idx_t
+    dll32_emplace(dll32_t * restrict dll, void * restrict data, size_t size, size_t pos) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || dll->objs_count < pos)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const dll32_idx_t new_obj = dll32_new_obj(dll, data, size);
+  const dll32_idx_t __ret   = dll32_insert(dll, new_obj, pos);
+
+  return __ret;
+}
+
+__dll_inline dll32_idx_t dll32_unlink(dll32_t * restrict dll, dll32_idx_t obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll32_obj_t * restrict objs = dll->objs;
+  const dll32_idx_t      next = objs[obj].next;
+  const dll32_idx_t      prev = objs[obj].prev;
+
+  if (LIBDLL32_NIL != prev) {
+    objs[prev].next = next;
+  } else {
+    dll->head = next;
+  }
+
+  if (LIBDLL32_NIL != next) {
+    objs[next].prev = prev;
+  } else {
+    dll->tail = prev;
+  }
+
+  objs[obj].next = LIBDLL32_NIL;
+  objs[obj].prev = LIBDLL32_NIL;
+  --dll->objs_count;
+
+  return obj;
+}
+
+/**
+ * \b Calls the \c destructor of list \p dll for \p data .
+ *
+ * \param dll list.
+ * \param data data of a list-object.
+ */
+__dll_inline void __dll32i_destroy_data(const dll32_t * restrict dll, void * restrict data) {
+  if (dll->destructor) {
+    if (LIBDLL_DESTRUCTOR_DEFAULT == dll->destructor) {
+      free(data);
+    } else {
+      dll->destructor(data);
+    }
+  }
+}
+
+__dll_inline bool dll32_free_obj(dll32_t * restrict dll, dll32_idx_t obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  __dll32i_destroy_data(dll, dll->objs[obj].data);
+
+  dll->objs[obj].data = NULL;
+  dll->objs[obj].next = dll->free_head;
+  dll->free_head      = obj;
+  return true;
+}
+
+__dll_inline bool dll32_delete(dll32_t * restrict dll, dll32_idx_t obj) {
+  const dll32_idx_t del_obj = dll32_unlink(dll, obj);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (LIBDLL32_NIL == del_obj) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const bool __ret = dll32_free_obj(dll, del_obj);
+
+  return __ret;
+}
+
+__dll_inline bool dll32_clear(dll32_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll32_obj_t * restrict objs = dll->objs;
+
+  for (dll32_idx_t iobj = dll->head; LIBDLL32_NIL != iobj;) {
+    const dll32_idx_t save = objs[iobj].next;
+
+    __dll32i_destroy_data(dll, objs[iobj].data);
+    objs[iobj].data = NULL;
+    objs[iobj].next = dll->free_head;
+    dll->free_head  = iobj;
+
+    iobj = save;
+  }
+
+  dll->head = dll->tail = LIBDLL32_NIL;
+  dll->objs_count       = 0;
+
+  return true;
+}
+
+__dll_inline bool dll32_free(dll32_t * restrict * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == *dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const bool __ret = dll32_clear(*dll);
+
+  free((*dll)->objs);
+  free(*dll);
+  *dll = NULL;
+
+  return __ret;
+}
+
+__dll_inline bool
+    dll32_foreach(const dll32_t * restrict dll, dll_callback_fn_t fn, void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const dll32_obj_t * restrict objs = dll->objs;
+  size_t                       i    = 0;
+
+  for (dll32_idx_t iobj = dll->head; LIBDLL32_NIL != iobj; iobj = objs[iobj].next) {
+    fn(objs[iobj].data, any, i++);
+  }
+
+  return true;
+}
+
+__dll_inline dll32_idx_t dll32_find(const dll32_t * restrict dll,
+                                    dll_callback_fn_t fn_search,
+                                    void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || NULL == fn_search)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const dll32_obj_t * restrict objs = dll->objs;
+  size_t                       i    = 0;
+
+  for (dll32_idx_t iobj = dll->head; LIBDLL32_NIL != iobj; iobj = objs[iobj].next) {
+    if (0 == fn_search(objs[iobj].data, any, i++)) {
+      return iobj;
+    }
+  }
+
+  return LIBDLL32_NIL;
+}
+
+__dll_inline dll32_iterator_t dll32_front(dll32_t * restrict dll) {
+  dll32_iterator_t it = {
+#ifndef LIBDLL_UNSAFE_USAGE
+      dll ? dll->head : LIBDLL32_NIL,
+#else
+      dll->head,
+#endif /* LIBDLL_UNSAFE_USAGE */
+      dll,
+      0};
+
+  return it;
+}
+
+__dll_inline dll32_iterator_t dll32_back(dll32_t * restrict dll) {
+  dll32_iterator_t it = {
+#ifndef LIBDLL_UNSAFE_USAGE
+      dll ? dll->tail : LIBDLL32_NIL,
+      dll,
+      dll && dll->objs_count ? dll->objs_count - 1 : 0,
+#else
+      dll->tail,
+      dll,
+      dll->objs_count ? dll->objs_count - 1 : 0,
+#endif /* LIBDLL_UNSAFE_USAGE */
+  };
+
+  return it;
+}
+
+__dll_inline bool dll32_next(dll32_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || NULL == it->__dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (LIBDLL32_NIL != it->__obj) {
+    it->__obj = it->__dll->objs[it->__obj].next;
+  }
+  ++it->__index;
+
+  return LIBDLL32_NIL != it->__obj;
+}
+
+__dll_inline bool dll32_prev(dll32_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || NULL == it->__dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (LIBDLL32_NIL != it->__obj) {
+    it->__obj = it->__dll->objs[it->__obj].prev;
+  }
+  --it->__index;
+
+  return LIBDLL32_NIL != it->__obj;
+}
+
+__dll_inline dll32_idx_t dll32_iterator_get_obj(const dll32_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return LIBDLL32_NIL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__obj;
+}
+
+__dll_inline void * dll32_iterator_get_data(const dll32_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it || LIBDLL32_NIL == it->__obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__dll->objs[it->__obj].data;
+}
+
+__dll_inline size_t dll32_iterator_get_index(const dll32_iterator_t * restrict const it) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return ~0UL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return it->__index;
+}
+
+__dll_inline void * dll32_obj_get_data(const dll32_t * restrict dll, dll32_idx_t obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll || LIBDLL32_NIL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return dll->objs[obj].data;
+}
+
+__dll_inline bool dll32_empty(const dll32_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  return !(dll && !!dll->objs_count);
+#else
+  return !dll->objs_count;
+#endif /* LIBDLL_UNSAFE_USAGE */
+}
+
+__dll_inline size_t dll32_size(const dll32_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return dll->objs_count;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLL32_H */
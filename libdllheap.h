@@ -0,0 +1,621 @@
+/**
+ * \file libdllheap.h
+ *
+ * \brief Pairing heap of libdll list-objects: O(1) push and meld, O(log n) amortized pop
+ * of the minimum and decrease-key through the list-object pointer.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLLHEAP_H
+#define LIBDLLHEAP_H
+
+#include "libdll.h"
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * A heap list-object structure. It is a #dll_obj_t with a pointer to its first child, so
+ * it may be linked to a #dll_t list as well, see #dll_heap_from_list and
+ * #dll_heap_drain .
+ *
+ * \note Inside of a heap \c obj.next points to the next sibling and \c obj.prev points
+ * to the previous sibling, or to the parent for the first child.
+ *
+ * \attention Lists holding heap list-objects must not be compacted by #dll_compact ,
+ * which relocates list-objects as plain #dll_obj_t .
+ *
+ * \typedef dll_heap_obj_t
+ */
+typedef struct __s_dll_heap_obj {
+  /** list-object with data, destructor and sibling links. */
+  dll_obj_t obj;
+  /** a pointer to the first child. */
+  struct __s_dll_heap_obj * child;
+} dll_heap_obj_t;
+
+/**
+ * A pairing heap structure, ordered by a comparator of list-objects data.
+ *
+ * \typedef dll_heap_t
+ */
+typedef struct {
+  /** a root of heap, the minimal list-object. */
+  dll_heap_obj_t * root;
+  /** a counter of list-objects in heap. */
+  size_t objs_count;
+  /** a comparator of list-objects data. */
+  dll_callback_ext_fn_t __cmp;
+  /** any data to be passed to \c __cmp . */
+  void * __any;
+} dll_heap_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Creates a new and empty heap ordered by \p fn_cmp .
+ *
+ * \param fn_cmp callback-function to compare list-objects data, as for #dll_sort .
+ * \param any any data to be passed to \p fn_cmp .
+ *
+ * \return allocated memory for new heap, \c NULL otherwise
+ */
+__dll_inline dll_heap_t * dll_heap_new(dll_callback_ext_fn_t fn_cmp, void * any);
+
+/**
+ * \b Creates a new heap list-object, which may be pushed to a heap or to a list.
+ *
+ * \param data any data you want to put inside of heap.
+ * \param size a size of \p data .
+ * \param destructor \destructor_description
+ *
+ * \return allocated memory for new heap list-object, \c NULL otherwise
+ */
+__dll_inline dll_heap_obj_t * dll_heap_new_obj(void * restrict data,
+                                               size_t                       size,
+                                               dll_callback_destructor_fn_t destructor);
+
+/**
+ * \b Pushes a heap list-object \p obj to \p heap in O(1).
+ *
+ * \param heap destination heap.
+ * \param obj unlinked heap list-object.
+ *
+ * \return \p obj on success, \c NULL otherwise
+ */
+__dll_inline dll_heap_obj_t * dll_heap_push(dll_heap_t * restrict     heap,
+                                            dll_heap_obj_t * restrict obj);
+
+/**
+ * \b Creates a new heap list-object via #dll_heap_new_obj and pushes it to \p heap .
+ *
+ * \param heap destination heap.
+ * \param data any data.
+ * \param size size of \p data.
+ * \param destructor \destructor_description
+ *
+ * \return a new heap list-object, \c NULL otherwise
+ */
+__dll_inline dll_heap_obj_t * dll_heap_emplace(dll_heap_t * restrict heap,
+                                               void * restrict data,
+                                               size_t                       size,
+                                               dll_callback_destructor_fn_t destructor);
+
+/**
+ * \b Access the minimal list-object of \p heap .
+ *
+ * \param heap heap.
+ *
+ * \return minimal heap list-object, \c NULL if heap is empty.
+ */
+__dll_inline dll_heap_obj_t * dll_heap_top(const dll_heap_t * restrict heap);
+
+/**
+ * \b Unlinks the minimal list-object from \p heap in O(log n) amortized.
+ *
+ * \param heap heap.
+ *
+ * \return unlinked heap list-object, \c NULL if heap is empty.
+ */
+__dll_inline dll_heap_obj_t * dll_heap_pop(dll_heap_t * restrict heap);
+
+/**
+ * \b Unlinks any list-object \p obj from \p heap in O(log n) amortized.
+ *
+ * \param heap heap.
+ * \param obj heap list-object of \p heap .
+ *
+ * \return \p obj on success, \c NULL otherwise.
+ */
+__dll_inline dll_heap_obj_t * dll_heap_unlink(dll_heap_t * restrict     heap,
+                                              dll_heap_obj_t * restrict obj);
+
+/**
+ * **Unlink and free** a list-object \p obj from \p heap .
+ *
+ * \param heap heap.
+ * \param obj heap list-object to be deleted.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_heap_delete(dll_heap_t * restrict     heap,
+                                  dll_heap_obj_t * restrict obj);
+
+/**
+ * \b Restores the order of \p heap after data of its list-object \p obj was changed to
+ * a smaller one, in O(1).
+ *
+ * \param heap heap.
+ * \param obj heap list-object of \p heap , which data became smaller.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_heap_decrease_key(dll_heap_t * restrict     heap,
+                                        dll_heap_obj_t * restrict obj);
+
+/**
+ * \b Moves all the list-objects of \p src heap to \p dst heap in O(1).
+ *
+ * \note Both heaps must be ordered by the same comparator.
+ *
+ * \param dst destination heap.
+ * \param src source heap, it's empty after the call.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_heap_meld(dll_heap_t * restrict dst, dll_heap_t * restrict src);
+
+/**
+ * \b Moves all the list-objects of \p dll list to \p heap in O(n).
+ *
+ * \attention All the list-objects of \p dll must be created by #dll_heap_new_obj .
+ *
+ * \param heap destination heap.
+ * \param dll source list, it's empty after the call.
+ *
+ * \return count of moved list-objects.
+ */
+__dll_inline size_t dll_heap_from_list(dll_heap_t * restrict heap, dll_t * restrict dll);
+
+/**
+ * \b Pops all the list-objects of \p heap to the end of \p dll list in order, in
+ * O(n log n).
+ *
+ * \param heap source heap, it's empty after the call unless a list-object couldn't be
+ * pushed to \p dll , then the rest of list-objects stay in \p heap .
+ * \param dll destination list.
+ *
+ * \return count of moved list-objects.
+ */
+__dll_inline size_t dll_heap_drain(dll_heap_t * restrict heap, dll_t * restrict dll);
+
+/**
+ * \b Erases all list-objects from the \p heap , calling their destructors.
+ *
+ * \param heap heap.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_heap_clear(dll_heap_t * restrict heap);
+
+/**
+ * \b Free the whole heap with all its list-objects and their data.
+ *
+ * \param heap heap.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_heap_free(dll_heap_t * restrict * restrict heap);
+
+/**
+ * \b Get the count of list-objects in the provided \p heap .
+ *
+ * \param heap heap.
+ *
+ * \return count of list-objects in the heap.
+ */
+__dll_inline size_t dll_heap_size(const dll_heap_t * restrict heap);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+__dll_inline dll_heap_t * dll_heap_new(dll_callback_ext_fn_t fn_cmp, void * any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == fn_cmp)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_heap_t * restrict out = (dll_heap_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->__cmp = fn_cmp;
+  out->__any = any;
+  return out;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_new_obj(void * restrict data,
+                                               size_t                       size,
+                                               dll_callback_destructor_fn_t destructor) {
+  dll_heap_obj_t * restrict out = (dll_heap_obj_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->obj.data       = data;
+  out->obj.size       = size;
+  out->obj.destructor = destructor;
+  return out;
+}
+
+/**
+ * \b Melds two heap roots \p a and \p b , making the greater one the first child of the
+ * other.
+ *
+ * \param heap heap which comparator orders the roots.
+ * \param a heap root, may be \c NULL .
+ * \param b heap root, may be \c NULL .
+ *
+ * \return root of the melded heap.
+ */
+__dll_inline dll_heap_obj_t * __dll_heapi_meld(const dll_heap_t * restrict heap,
+                                               dll_heap_obj_t *            a,
+                                               dll_heap_obj_t *            b) {
+  if (NULL == a || NULL == b) {
+    return a ? a : b;
+  }
+
+  if (0 > heap->__cmp(b->obj.data, a->obj.data, heap->__any, ~0UL)) {
+    dll_heap_obj_t * save = a;
+
+    a = b;
+    b = save;
+  }
+
+  b->obj.next = (dll_obj_t *)a->child;
+  b->obj.prev = &a->obj;
+  if (a->child) {
+    a->child->obj.prev = &b->obj;
+  }
+  a->child = b;
+
+  return a;
+}
+
+/**
+ * \b Melds siblings starting at \p first into one heap in two passes: melding pairs
+ * from left to right, then the pairs from right to left.
+ *
+ * \param heap heap which comparator orders the roots.
+ * \param first first sibling, may be \c NULL .
+ *
+ * \return root of the melded heap.
+ */
+__dll_inline dll_heap_obj_t *
+    __dll_heapi_meld_siblings(const dll_heap_t * restrict heap, dll_heap_obj_t * first) {
+  dll_heap_obj_t * pairs = NULL;
+
+  while (first) {
+    dll_heap_obj_t * a = first;
+    dll_heap_obj_t * b = (dll_heap_obj_t *)a->obj.next;
+
+    first       = b ? (dll_heap_obj_t *)b->obj.next : NULL;
+    a->obj.next = a->obj.prev = NULL;
+    if (b) {
+      b->obj.next = b->obj.prev = NULL;
+      a                         = __dll_heapi_meld(heap, a, b);
+    }
+
+    // melded pairs are stacked through next, so the second pass goes right to left
+    a->obj.next = (dll_obj_t *)pairs;
+    pairs       = a;
+  }
+
+  dll_heap_obj_t * root = NULL;
+
+  while (pairs) {
+    dll_heap_obj_t * save = (dll_heap_obj_t *)pairs->obj.next;
+
+    pairs->obj.next = NULL;
+    root            = __dll_heapi_meld(heap, root, pairs);
+    pairs           = save;
+  }
+
+  return root;
+}
+
+/**
+ * \b Cuts a non-root \p obj with its children from its parent.
+ *
+ * \param obj heap list-object.
+ */
+__dll_inline void __dll_heapi_cut(dll_heap_obj_t * restrict obj) {
+  dll_heap_obj_t * prev = (dll_heap_obj_t *)obj->obj.prev;
+
+  if (prev->child == obj) {
+    prev->child = (dll_heap_obj_t *)obj->obj.next;
+  } else {
+    prev->obj.next = obj->obj.next;
+  }
+  if (obj->obj.next) {
+    obj->obj.next->prev = &prev->obj;
+  }
+
+  obj->obj.next = NULL;
+  obj->obj.prev = NULL;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_push(dll_heap_t * restrict     heap,
+                                            dll_heap_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  obj->obj.next = NULL;
+  obj->obj.prev = NULL;
+  obj->child    = NULL;
+
+  heap->root = __dll_heapi_meld(heap, heap->root, obj);
+  ++heap->objs_count;
+
+  return obj;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_emplace(dll_heap_t * restrict heap,
+                                               void * restrict data,
+                                               size_t                       size,
+                                               dll_callback_destructor_fn_t destructor) {
+  dll_heap_obj_t * restrict new_obj = dll_heap_new_obj(data, size, destructor);
+  dll_heap_obj_t * restrict __ret   = dll_heap_push(heap, new_obj);
+
+  return __ret;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_top(const dll_heap_t * restrict heap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return heap->root;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_pop(dll_heap_t * restrict heap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == heap->root)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_heap_obj_t * restrict __ret = heap->root;
+
+  heap->root   = __dll_heapi_meld_siblings(heap, __ret->child);
+  __ret->child = NULL;
+  --heap->objs_count;
+
+  return __ret;
+}
+
+__dll_inline dll_heap_obj_t * dll_heap_unlink(dll_heap_t * restrict     heap,
+                                              dll_heap_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (obj == heap->root) {
+    dll_heap_obj_t * restrict __ret = dll_heap_pop(heap);
+
+    return __ret;
+  }
+
+  __dll_heapi_cut(obj);
+
+  dll_heap_obj_t * children = __dll_heapi_meld_siblings(heap, obj->child);
+
+  heap->root = __dll_heapi_meld(heap, heap->root, children);
+  obj->child = NULL;
+  --heap->objs_count;
+
+  return obj;
+}
+
+__dll_inline bool dll_heap_delete(dll_heap_t * restrict     heap,
+                                  dll_heap_obj_t * restrict obj) {
+  dll_obj_t * restrict del_obj = (dll_obj_t *)dll_heap_unlink(heap, obj);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (NULL == del_obj) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const bool __ret = dll_free_obj(&del_obj);
+
+  return __ret;
+}
+
+__dll_inline bool dll_heap_decrease_key(dll_heap_t * restrict     heap,
+                                        dll_heap_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == obj)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (obj != heap->root) {
+    __dll_heapi_cut(obj);
+    heap->root = __dll_heapi_meld(heap, heap->root, obj);
+  }
+
+  return true;
+}
+
+__dll_inline bool dll_heap_meld(dll_heap_t * restrict dst, dll_heap_t * restrict src) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dst || NULL == src)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dst->root = __dll_heapi_meld(dst, dst->root, src->root);
+  dst->objs_count += src->objs_count;
+
+  src->root       = NULL;
+  src->objs_count = 0;
+
+  return true;
+}
+
+__dll_inline size_t dll_heap_from_list(dll_heap_t * restrict heap, dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == dll)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_obj_t * last       = NULL;
+  size_t      moved_objs = 0;
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return 0;
+  }
+  for (dll_obj_t * iobj = __dlli_detach(dll, &last); iobj; ++moved_objs) {
+    dll_obj_t * save = iobj->next;
+
+    dll_heap_push(heap, (dll_heap_obj_t *)iobj);
+    iobj = save;
+  }
+
+  return moved_objs;
+}
+
+__dll_inline size_t dll_heap_drain(dll_heap_t * restrict heap, dll_t * restrict dll) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == dll)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  size_t moved_objs = 0;
+
+  if (__dll_unlikely(!__dlli_cow(dll))) {
+    return 0;
+  }
+  for (; heap->root; ++moved_objs) {
+    dll_heap_obj_t * obj = dll_heap_pop(heap);
+
+    // a list-object that couldn't be pushed goes back to the heap instead of being lost
+    if (__dll_unlikely(NULL == dll_push_back(dll, &obj->obj))) {
+      dll_heap_push(heap, obj);
+      break;
+    }
+  }
+
+  return moved_objs;
+}
+
+__dll_inline bool dll_heap_clear(dll_heap_t * restrict heap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_heap_obj_t * iobj = heap->root;
+
+  // the heap is a binary tree of first children and next siblings, rotating the child
+  // subtrees into sibling chains frees it without recursion or a stack
+  while (iobj) {
+    dll_heap_obj_t * child = iobj->child;
+
+    if (child) {
+      iobj->child     = (dll_heap_obj_t *)child->obj.next;
+      child->obj.next = &iobj->obj;
+      iobj            = child;
+    } else {
+      dll_heap_obj_t * save = (dll_heap_obj_t *)iobj->obj.next;
+
+      __dlli_destroy_obj(&iobj->obj);
+      iobj = save;
+    }
+  }
+
+  heap->root       = NULL;
+  heap->objs_count = 0;
+
+  return true;
+}
+
+__dll_inline bool dll_heap_free(dll_heap_t * restrict * restrict heap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap || NULL == *heap)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_heap_clear(*heap);
+  free(*heap);
+  *heap = NULL;
+
+  return true;
+}
+
+__dll_inline size_t dll_heap_size(const dll_heap_t * restrict heap) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == heap)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return heap->objs_count;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLLHEAP_H */
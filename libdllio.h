@@ -0,0 +1,820 @@
+/**
+ * \file libdllio.h
+ *
+ * \brief Binary serialization of libdll lists to and from file descriptors, with
+ * vectored writes and chunked reads.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLLIO_H
+#define LIBDLLIO_H
+
+#include "libdll.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// libdllio specifications and macroses
+// ----------------------------
+//
+
+/**
+ * Magic bytes opening a serialized list.
+ */
+#define LIBDLL_IO_MAGIC "LDLL"
+
+/**
+ * Magic bytes opening a mapped list file, see #dll_map_write_fd .
+ */
+#define LIBDLL_MAP_MAGIC "LDLM"
+
+/**
+ * Version of the serialized and mapped list formats.
+ */
+#define LIBDLL_IO_VERSION 1
+
+#ifndef LIBDLL_IO_IOVS
+/**
+ * Maximum count of buffers gathered by one \c writev call of #dll_serialize_fd , must
+ * not exceed \c IOV_MAX .
+ */
+#  define LIBDLL_IO_IOVS 1024
+#endif /* LIBDLL_IO_IOVS */
+
+#ifndef LIBDLL_IO_CHUNK
+/**
+ * Size in bytes of chunks read by #dll_deserialize_fd . Payloads bigger than a chunk are
+ * read straight into their own memory.
+ */
+#  define LIBDLL_IO_CHUNK (256UL * 1024UL)
+#endif /* LIBDLL_IO_CHUNK */
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * A header of a serialized list. It's followed by \c objs_count records of a \c uint64_t
+ * payload size and the payload bytes. All the numbers are in host byte order.
+ *
+ * \typedef dll_io_header_t
+ */
+typedef struct {
+  /** #LIBDLL_IO_MAGIC without the terminating null byte. */
+  char magic[4];
+  /** #LIBDLL_IO_VERSION . */
+  uint32_t version;
+  /** a count of records following the header. */
+  uint64_t objs_count;
+} dll_io_header_t;
+
+/**
+ * A header of a mapped list file, see #dll_map_write_fd . Offsets are counted from the
+ * start of the file, \c 0 stands for none. All the numbers are in host byte order.
+ *
+ * \typedef dll_map_header_t
+ */
+typedef struct {
+  /** #LIBDLL_MAP_MAGIC without the terminating null byte. */
+  char magic[4];
+  /** #LIBDLL_IO_VERSION . */
+  uint32_t version;
+  /** a count of list-objects in the file. */
+  uint64_t objs_count;
+  /** an offset of the first list-object. */
+  uint64_t head;
+  /** an offset of the last list-object. */
+  uint64_t tail;
+  /** a size of the whole file. */
+  uint64_t length;
+} dll_map_header_t;
+
+/**
+ * A list-object of a mapped list file. Its payload follows inline, padded to 8 bytes.
+ *
+ * \typedef dll_map_obj_t
+ */
+typedef struct {
+  /** an offset of the next list-object. */
+  uint64_t next;
+  /** an offset of the previous list-object. */
+  uint64_t prev;
+  /** a size of \c data . */
+  uint64_t size;
+  /** inline payload. */
+  unsigned char data[];
+} dll_map_obj_t;
+
+/**
+ * A read-only view of a mapped list file, see #dll_map_open_fd .
+ *
+ * \typedef dll_map_t
+ */
+typedef struct {
+  /** the mapped file. */
+  const dll_map_header_t * header;
+  /** a size of the mapping. */
+  size_t length;
+} dll_map_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Writes \p dll to \p fd : a #dll_io_header_t and a length-prefixed record of
+ * \c data of \c size bytes for each list-object. Lengths and payloads are gathered into
+ * \c writev batches of #LIBDLL_IO_IOVS buffers, so payloads aren't copied and the count
+ * of system calls doesn't grow with the count of list-objects one to one.
+ *
+ * \note List-objects with \c NULL \c data are written as empty records.
+ *
+ * \param dll list.
+ * \param fd file descriptor open for writing.
+ *
+ * \return \c true on success, \c false otherwise and \c errno is set by the failed call.
+ */
+__dll_inline bool dll_serialize_fd(const dll_t * restrict dll, int fd);
+
+/**
+ * \b Reads a list written by #dll_serialize_fd from \p fd in chunks of
+ * #LIBDLL_IO_CHUNK bytes. Only one chunk is buffered at a time, so lists of any size
+ * may be streamed. Nothing past the list is read, so several lists written one after
+ * another to a pipe or a socket are read back by as many calls.
+ *
+ * \note List-objects are allocated in bulk from storage blocks, as by #dll_compact .
+ * Every payload is allocated by \c malloc and freed by #LIBDLL_DESTRUCTOR_DEFAULT ,
+ * empty records get \c NULL \c data .
+ *
+ * \param fd file descriptor open for reading.
+ *
+ * \return a new list, \c NULL if reading failed or the data is not a serialized list.
+ */
+__dll_inline dll_t * dll_deserialize_fd(int fd);
+
+/**
+ * \b Writes \p dll to \p fd as a mapped list file: a #dll_map_header_t and a
+ * #dll_map_obj_t for each list-object with its payload inline, linked by file offsets
+ * instead of pointers. Written with \c writev batches as #dll_serialize_fd does.
+ *
+ * \param dll list.
+ * \param fd file descriptor of a regular file open for writing, at its start.
+ *
+ * \return \c true on success, \c false otherwise and \c errno is set by the failed call.
+ */
+__dll_inline bool dll_map_write_fd(const dll_t * restrict dll, int fd);
+
+/**
+ * \b Maps a file written by #dll_map_write_fd for read-only traversal. Nothing is read
+ * or copied up front, pages are faulted in as list-objects are visited.
+ *
+ * \note \p fd may be closed right after the call.
+ *
+ * \param fd file descriptor open for reading.
+ *
+ * \return a new view of the mapped list, \c NULL if mapping failed or the file is not a
+ * mapped list.
+ */
+__dll_inline dll_map_t * dll_map_open_fd(int fd);
+
+/**
+ * \b Get the first list-object of the mapped list.
+ *
+ * \param map mapped list.
+ *
+ * \return first list-object, \c NULL if \p map is empty.
+ */
+__dll_inline const dll_map_obj_t * dll_map_head(const dll_map_t * restrict map);
+
+/**
+ * \b Get the last list-object of the mapped list.
+ *
+ * \param map mapped list.
+ *
+ * \return last list-object, \c NULL if \p map is empty.
+ */
+__dll_inline const dll_map_obj_t * dll_map_tail(const dll_map_t * restrict map);
+
+/**
+ * \b Get the list-object after \p obj .
+ *
+ * \note Offsets are bounds-checked against the mapping, so a corrupted file ends the
+ * traversal instead of faulting. Define #LIBDLL_UNSAFE_USAGE to skip the checks.
+ *
+ * \param map mapped list.
+ * \param obj list-object of \p map .
+ *
+ * \return next list-object, \c NULL at the end of \p map .
+ */
+__dll_inline const dll_map_obj_t * dll_map_next(const dll_map_t * restrict map,
+                                                const dll_map_obj_t * restrict obj);
+
+/**
+ * \b Get the list-object before \p obj , bounds-checked as by #dll_map_next .
+ *
+ * \param map mapped list.
+ * \param obj list-object of \p map .
+ *
+ * \return previous list-object, \c NULL at the start of \p map .
+ */
+__dll_inline const dll_map_obj_t * dll_map_prev(const dll_map_t * restrict map,
+                                                const dll_map_obj_t * restrict obj);
+
+/**
+ * \b Get the count of list-objects in the mapped list.
+ *
+ * \param map mapped list.
+ *
+ * \return count of list-objects.
+ */
+__dll_inline size_t dll_map_size(const dll_map_t * restrict map);
+
+/**
+ * \b Calls \p fn for each payload of the mapped list, as #dll_foreach does. Empty
+ * payloads are passed as \c NULL .
+ *
+ * \attention Payloads live in a read-only mapping, \p fn must not modify them.
+ *
+ * \note The walk stops after #dll_map_size list-objects, even if the links of a
+ * corrupted file go on.
+ *
+ * \param map mapped list.
+ * \param fn callback-function.
+ * \param any any data to be passed to \p fn .
+ *
+ * \return \c true on success, \c false otherwise or if the list ends before
+ * #dll_map_size list-objects.
+ */
+__dll_inline bool dll_map_foreach(const dll_map_t * restrict map,
+                                  dll_callback_fn_t fn,
+                                  void * restrict any);
+
+/**
+ * \b Copies the mapped list to a new heap list, which may be modified. List-objects are
+ * allocated as by #dll_deserialize_fd .
+ *
+ * \param map mapped list.
+ *
+ * \return a new list, \c NULL otherwise
+ */
+__dll_inline dll_t * dll_map_to_list(const dll_map_t * restrict map);
+
+/**
+ * \b Unmaps the mapped list and frees its view.
+ *
+ * \param map mapped list.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_map_close(dll_map_t * restrict * restrict map);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+/**
+ * \b Writes all the \p iovcnt buffers of \p iov to \p fd , resuming after partial
+ * writes and interrupts.
+ *
+ * \param fd file descriptor.
+ * \param iov buffers, modified by partial writes.
+ * \param iovcnt count of buffers.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool __dll_ioi_writev(int fd, struct iovec * iov, int iovcnt) {
+  while (iovcnt) {
+    ssize_t written = writev(fd, iov, iovcnt);
+
+    if (0 > written) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+
+    while (iovcnt && (size_t)written >= iov->iov_len) {
+      written -= (ssize_t)iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+    if (iovcnt) {
+      iov->iov_base = (char *)iov->iov_base + written;
+      iov->iov_len -= (size_t)written;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * A chunked reader of #dll_deserialize_fd .
+ */
+typedef struct {
+  /** file descriptor. */
+  int fd;
+  /** position of the next unread byte in \c buf . */
+  size_t pos;
+  /** count of bytes in \c buf . */
+  size_t len;
+  /** count of bytes not read from \c fd yet, which are known to belong to the list. */
+  size_t left;
+  /** chunk buffer of #LIBDLL_IO_CHUNK bytes. */
+  char * buf;
+} __dll_ioi_reader_t;
+
+/**
+ * \b Adds \p size bytes to the bytes which \p reader may read from its file descriptor,
+ * once the list is known to hold them.
+ *
+ * \param reader chunked reader.
+ * \param size count of bytes.
+ *
+ * \return \c false if the count overflows, as only a corrupted list makes it.
+ */
+__dll_inline bool __dll_ioi_expect(__dll_ioi_reader_t * restrict reader, uint64_t size) {
+  if (__dll_unlikely(SIZE_MAX - reader->left < size)) {
+    return false;
+  }
+
+  reader->left += (size_t)size;
+  return true;
+}
+
+/**
+ * \b Reads exactly \p size bytes to \p dst through the chunk buffer of \p reader .
+ *
+ * \note Reads from the file descriptor never go past the bytes the list is known to
+ * hold, see #__dll_ioi_expect .
+ *
+ * \param reader chunked reader.
+ * \param dst destination memory.
+ * \param size count of bytes.
+ *
+ * \return \c true on success, \c false on errors or a premature end of file.
+ */
+__dll_inline bool __dll_ioi_read(__dll_ioi_reader_t * restrict reader,
+                                 void * restrict dst,
+                                 size_t size) {
+  char * restrict out = (char *)dst;
+
+  while (size) {
+    if (reader->pos < reader->len) {
+      const size_t count =
+          reader->len - reader->pos < size ? reader->len - reader->pos : size;
+
+      memcpy(out, reader->buf + reader->pos, count);
+      reader->pos += count;
+      out += count;
+      size -= count;
+      continue;
+    }
+
+    if (__dll_unlikely(reader->left < size)) {
+      return false;
+    }
+
+    // big payloads bypass the chunk buffer
+    const bool   direct = LIBDLL_IO_CHUNK <= size;
+    const size_t chunk  = LIBDLL_IO_CHUNK < reader->left ? LIBDLL_IO_CHUNK : reader->left;
+    ssize_t      got    = direct ? read(reader->fd, out, size)
+                                 : read(reader->fd, reader->buf, chunk);
+
+    if (0 > got && EINTR == errno) {
+      continue;
+    }
+    if (0 >= got) {
+      return false;
+    }
+
+    reader->left -= (size_t)got;
+    if (direct) {
+      out += got;
+      size -= (size_t)got;
+    } else {
+      reader->pos = 0;
+      reader->len = (size_t)got;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * \b Appends a list-object for \p data of \p size bytes to \p dll , taking it from
+ * \p block , which is replaced by a new storage block when it's full.
+ *
+ * \param dll list.
+ * \param block storage block referenced by the caller, or \c NULL .
+ * \param data payload allocated by \c malloc , or \c NULL for empty ones.
+ * \param size size of \p data .
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool __dll_ioi_append(dll_t * restrict dll,
+                                   dll_block_t ** restrict block,
+                                   void * restrict data,
+                                   size_t size) {
+  if (NULL == *block || __DLLI_BLOCK_OBJS == (*block)->__used) {
+    if (*block) {
+      __dlli_block_release(*block, 1);
+    }
+    if (NULL == (*block = __dlli_block_new())) {
+      return false;
+    }
+  }
+
+  dll_obj_t * restrict obj = __dlli_block_take(*block);
+
+  memset(obj, 0, sizeof(*obj));
+  obj->data       = data;
+  obj->size       = size;
+  obj->destructor = size ? LIBDLL_DESTRUCTOR_DEFAULT : LIBDLL_DESTRUCTOR_NULL;
+  dll_push_back(dll, obj);
+
+  return true;
+}
+
+__dll_inline bool dll_serialize_fd(const dll_t * restrict dll, int fd) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_io_header_t header = {{'L', 'D', 'L', 'L'}, LIBDLL_IO_VERSION, dll->objs_count};
+  struct iovec    iov[LIBDLL_IO_IOVS];
+  uint64_t        sizes[LIBDLL_IO_IOVS];
+  int             iovcnt = 1;
+  size_t          nsizes = 0;
+
+  iov[0].iov_base = &header;
+  iov[0].iov_len  = sizeof(header);
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    if (LIBDLL_IO_IOVS < iovcnt + 2) {
+      if (!__dll_ioi_writev(fd, iov, iovcnt)) {
+        return false;
+      }
+      iovcnt = 0;
+      nsizes = 0;
+    }
+
+    sizes[nsizes]         = iobj->data ? (uint64_t)iobj->size : 0;
+    iov[iovcnt].iov_base  = &sizes[nsizes];
+    iov[iovcnt++].iov_len = sizeof(*sizes);
+    if (sizes[nsizes++]) {
+      iov[iovcnt].iov_base  = iobj->data;
+      iov[iovcnt++].iov_len = iobj->size;
+    }
+  }
+
+  return __dll_ioi_writev(fd, iov, iovcnt);
+}
+
+__dll_inline dll_t * dll_deserialize_fd(int fd) {
+  __dll_ioi_reader_t reader = {fd, 0, 0, sizeof(dll_io_header_t),
+                               (char *)malloc(LIBDLL_IO_CHUNK)};
+  dll_io_header_t    header;
+  dll_t * restrict   out   = NULL;
+  dll_block_t *      block = NULL;
+
+  if (NULL == reader.buf || !__dll_ioi_read(&reader, &header, sizeof(header)) ||
+      memcmp(header.magic, LIBDLL_IO_MAGIC, sizeof(header.magic)) ||
+      LIBDLL_IO_VERSION != header.version ||
+      UINT64_MAX / sizeof(uint64_t) < header.objs_count ||
+      !__dll_ioi_expect(&reader, header.objs_count * sizeof(uint64_t)) ||
+      NULL == (out = dll_new())) {
+    free(reader.buf);
+    return NULL;
+  }
+
+  for (uint64_t i = 0; header.objs_count > i; ++i) {
+    uint64_t size = 0;
+    void *   data = NULL;
+
+    if (!__dll_ioi_read(&reader, &size, sizeof(size)) ||
+        !__dll_ioi_expect(&reader, size)) {
+      break;
+    }
+    if (size && (NULL == (data = malloc(size)) || !__dll_ioi_read(&reader, data, size))) {
+      free(data);
+      break;
+    }
+
+    if (!__dll_ioi_append(out, &block, data, (size_t)size)) {
+      free(data);
+      break;
+    }
+  }
+
+  if (block) {
+    __dlli_block_release(block, 1);
+  }
+  free(reader.buf);
+
+  if (header.objs_count != out->objs_count) {
+    dll_free(&out);
+    return NULL;
+  }
+
+  return out;
+}
+
+/** A size of the inline payload of \p _size bytes padded to 8 bytes. */
+#define __DLL_IOI_PADDED(_size) (((_size) + 7) & ~(uint64_t)7)
+
+__dll_inline bool dll_map_write_fd(const dll_t * restrict dll, int fd) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == dll)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  static const unsigned char padding[8] = {0};
+
+  dll_map_header_t header = {
+      {'L', 'D', 'L', 'M'}, LIBDLL_IO_VERSION, dll->objs_count, 0, 0, 0};
+  dll_map_obj_t    objs[LIBDLL_IO_IOVS];
+  struct iovec     iov[LIBDLL_IO_IOVS];
+  int              iovcnt = 1;
+  size_t           nobjs  = 0;
+  uint64_t         offset = sizeof(header);
+  uint64_t         prev   = 0;
+
+  // offsets of all the list-objects are known from their sizes, count them up front
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    const uint64_t size = iobj->data ? (uint64_t)iobj->size : 0;
+
+    header.tail = offset;
+    offset += sizeof(dll_map_obj_t) + __DLL_IOI_PADDED(size);
+  }
+  header.head   = dll->head ? sizeof(header) : 0;
+  header.length = offset;
+  offset        = sizeof(header);
+
+  iov[0].iov_base = &header;
+  iov[0].iov_len  = sizeof(header);
+
+  for (dll_obj_t * restrict iobj = dll->head; iobj; iobj = __dlli_next(dll, iobj)) {
+    const uint64_t size   = iobj->data ? (uint64_t)iobj->size : 0;
+    const uint64_t padded = __DLL_IOI_PADDED(size);
+
+    if (LIBDLL_IO_IOVS < iovcnt + 3) {
+      if (!__dll_ioi_writev(fd, iov, iovcnt)) {
+        return false;
+      }
+      iovcnt = 0;
+      nobjs  = 0;
+    }
+
+    dll_map_obj_t * restrict obj = &objs[nobjs++];
+
+    obj->prev = prev;
+    obj->next = __dlli_next(dll, iobj) ? offset + sizeof(*obj) + padded : 0;
+    obj->size = size;
+    prev      = offset;
+    offset += sizeof(*obj) + padded;
+
+    iov[iovcnt].iov_base  = obj;
+    iov[iovcnt++].iov_len = sizeof(*obj);
+    if (size) {
+      iov[iovcnt].iov_base  = iobj->data;
+      iov[iovcnt++].iov_len = size;
+    }
+    if (padded != size) {
+      iov[iovcnt].iov_base  = (void *)padding;
+      iov[iovcnt++].iov_len = padded - size;
+    }
+  }
+
+  return __dll_ioi_writev(fd, iov, iovcnt);
+}
+
+__dll_inline dll_map_t * dll_map_open_fd(int fd) {
+  struct stat st;
+
+  if (0 != fstat(fd, &st) || sizeof(dll_map_header_t) > (uint64_t)st.st_size) {
+    return NULL;
+  }
+
+  const size_t length = (size_t)st.st_size;
+  void *       base   = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  if (MAP_FAILED == base) {
+    return NULL;
+  }
+
+  const dll_map_header_t * header = (const dll_map_header_t *)base;
+  dll_map_t *              out    = NULL;
+
+  if (memcmp(header->magic, LIBDLL_MAP_MAGIC, sizeof(header->magic)) ||
+      LIBDLL_IO_VERSION != header->version || length != header->length ||
+      NULL == (out = (dll_map_t *)malloc(sizeof(*out)))) {
+    munmap(base, length);
+    return NULL;
+  }
+
+  out->header = header;
+  out->length = length;
+  return out;
+}
+
+/**
+ * \b Get the list-object at \p offset of the mapped list, checking that it lies inside
+ * the mapping unless #LIBDLL_UNSAFE_USAGE is defined.
+ *
+ * \param map mapped list.
+ * \param offset offset of a list-object, \c 0 for none.
+ *
+ * \return list-object, \c NULL for none or out of bounds offsets.
+ */
+__dll_inline const dll_map_obj_t * __dll_ioi_map_at(const dll_map_t * restrict map,
+                                                    uint64_t offset) {
+  if (0 == offset) {
+    return NULL;
+  }
+
+  const dll_map_obj_t * obj =
+      (const dll_map_obj_t *)((const unsigned char *)map->header + offset);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(sizeof(dll_map_header_t) > offset || (offset & 7) ||
+                     map->length - sizeof(*obj) < offset ||
+                     map->length - sizeof(*obj) - offset < obj->size)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return obj;
+}
+
+__dll_inline const dll_map_obj_t * dll_map_head(const dll_map_t * restrict map) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_ioi_map_at(map, map->header->head);
+}
+
+__dll_inline const dll_map_obj_t * dll_map_tail(const dll_map_t * restrict map) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_ioi_map_at(map, map->header->tail);
+}
+
+__dll_inline const dll_map_obj_t * dll_map_next(const dll_map_t * restrict map,
+                                                const dll_map_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_ioi_map_at(map, obj->next);
+}
+
+__dll_inline const dll_map_obj_t * dll_map_prev(const dll_map_t * restrict map,
+                                                const dll_map_obj_t * restrict obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_ioi_map_at(map, obj->prev);
+}
+
+__dll_inline size_t dll_map_size(const dll_map_t * restrict map) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return (size_t)map->header->objs_count;
+}
+
+__dll_inline bool dll_map_foreach(const dll_map_t * restrict map,
+                                  dll_callback_fn_t fn,
+                                  void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map || NULL == fn)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const uint64_t count = map->header->objs_count;
+  uint64_t       i     = 0;
+
+  // a corrupted file may link list-objects into a cycle, so the walk takes no more
+  // steps than there are list-objects
+  for (const dll_map_obj_t * iobj = dll_map_head(map); iobj && count > i;
+       iobj                        = dll_map_next(map, iobj)) {
+    fn(iobj->size ? (void *)iobj->data : NULL, any, (size_t)i++);
+  }
+
+  return count == i;
+}
+
+__dll_inline dll_t * dll_map_to_list(const dll_map_t * restrict map) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const uint64_t   count = map->header->objs_count;
+  dll_t * restrict out   = dll_new();
+  dll_block_t *    block = NULL;
+
+  if (NULL == out) {
+    return NULL;
+  }
+
+  // bounded as in #dll_map_foreach
+  for (const dll_map_obj_t * iobj = dll_map_head(map); iobj && count > out->objs_count;
+       iobj                        = dll_map_next(map, iobj)) {
+    void * data = NULL;
+
+    if (iobj->size && NULL == (data = malloc((size_t)iobj->size))) {
+      break;
+    }
+    if (data) {
+      memcpy(data, iobj->data, (size_t)iobj->size);
+    }
+    if (!__dll_ioi_append(out, &block, data, (size_t)iobj->size)) {
+      free(data);
+      break;
+    }
+  }
+
+  if (block) {
+    __dlli_block_release(block, 1);
+  }
+
+  if (count != out->objs_count) {
+    dll_free(&out);
+    return NULL;
+  }
+
+  return out;
+}
+
+__dll_inline bool dll_map_close(dll_map_t * restrict * restrict map) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == map || NULL == *map)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  munmap((void *)(*map)->header, (*map)->length);
+  free(*map);
+  *map = NULL;
+
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLLIO_H */
@@ -0,0 +1,541 @@
+/**
+ * \file libdllpipe.h
+ *
+ * \brief Lazy pipelines over libdll lists: filter, map, skip, take and enumerate stages
+ * fused into one traversal without intermediate arrays or lists.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLLPIPE_H
+#define LIBDLLPIPE_H
+
+#include "libdll.h"
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// libdllpipe specifications and macroses
+// ----------------------------
+//
+
+#ifndef LIBDLL_PIPE_STAGES
+/**
+ * Maximum count of stages of one pipeline, see #dll_pipe_t .
+ */
+#  define LIBDLL_PIPE_STAGES 8
+#endif /* LIBDLL_PIPE_STAGES */
+
+/** Kinds of pipeline stages, see #dll_pipe_stage_t . */
+#define __DLL_PIPEI_FILTER    0
+#define __DLL_PIPEI_MAP       1
+#define __DLL_PIPEI_SKIP      2
+#define __DLL_PIPEI_TAKE      3
+#define __DLL_PIPEI_ENUMERATE 4
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * A callback function for #dll_pipe_reduce .
+ *
+ * \param acc accumulated value, the initial one for the first call.
+ * \param obj_data data which passed all the stages of a pipeline.
+ * \param any an any additional data.
+ * \param index an index of \p obj_data , see #dll_pipe_t .
+ *
+ * \return new accumulated value.
+ */
+typedef void * (*dll_callback_reduce_fn_t)(void *          acc,
+                                           void * restrict obj_data,
+                                           void * restrict any,
+                                           size_t          index);
+
+/**
+ * A stage of a pipeline, see #dll_pipe_t .
+ *
+ * \typedef dll_pipe_stage_t
+ */
+typedef struct {
+  /** kind of the stage, one of \c __DLL_PIPEI_* . */
+  int __kind;
+  /** callback-function of a filter stage. */
+  dll_callback_fn_t __filter;
+  /** callback-function of a map stage. */
+  dll_callback_mapper_fn_t __mapper;
+  /** any data to be passed to the callback-function. */
+  void * __any;
+  /** data left to be skipped or taken, or the next index of an enumerate stage. */
+  size_t __n;
+} dll_pipe_stage_t;
+
+/**
+ * A lazy pipeline over list-objects of a list, see #dll_pipe .
+ *
+ * \note Stages run in the order they were added, for one list-object at a time, while
+ * the list is walked once. Callback-functions get the index of a list-object in the
+ * list, or its index among data which passed the last #dll_pipe_enumerate stage before
+ * them.
+ *
+ * \attention The list must not be modified while the pipeline runs. A pipeline runs
+ * once, skip and take stages count down while it runs.
+ *
+ * \typedef dll_pipe_t
+ */
+typedef struct {
+  /** the next list-object to be passed through the stages. */
+  dll_obj_t * __obj;
+  /** the list being walked. */
+  const dll_t * __dll;
+  /** index of \c __obj . */
+  size_t __index;
+  /** \c true once a take stage has taken all of its data. */
+  bool __done;
+  /** count of stages. */
+  size_t __stages_count;
+  /** stages of the pipeline. */
+  dll_pipe_stage_t __stages[LIBDLL_PIPE_STAGES];
+} dll_pipe_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Creates a pipeline without stages over the list of iterator \p it , starting at
+ * its current list-object. The iterator isn't moved.
+ *
+ * \param it an iterator.
+ *
+ * \return a new pipeline, empty if \p it is \c NULL .
+ */
+__dll_inline dll_pipe_t dll_pipe(const dll_iterator_t * restrict it);
+
+/**
+ * \b Adds a stage to \p pipe which passes on data for which \p fn_cmp returns zero,
+ * as #dll_find finds it.
+ *
+ * \param pipe pipeline.
+ * \param fn_cmp callback-function to decide whether given data passes.
+ * \param any any data to be passed to \p fn_cmp .
+ *
+ * \return \p pipe on success, \c NULL otherwise or if it has #LIBDLL_PIPE_STAGES stages
+ */
+__dll_inline dll_pipe_t * dll_pipe_filter(dll_pipe_t * restrict pipe,
+                                          dll_callback_fn_t fn_cmp,
+                                          void * restrict any);
+
+/**
+ * \b Adds a stage to \p pipe which passes on the result of \p mapper instead of given
+ * data.
+ *
+ * \param pipe pipeline.
+ * \param mapper callback-function to produce new data for given data.
+ * \param any any data to be passed to \p mapper .
+ *
+ * \return \p pipe on success, \c NULL otherwise or if it has #LIBDLL_PIPE_STAGES stages
+ */
+__dll_inline dll_pipe_t * dll_pipe_map(dll_pipe_t * restrict pipe,
+                                       dll_callback_mapper_fn_t mapper,
+                                       void * restrict any);
+
+/**
+ * \b Adds a stage to \p pipe which drops the first \p count data it is given.
+ *
+ * \param pipe pipeline.
+ * \param count count of data to be dropped.
+ *
+ * \return \p pipe on success, \c NULL otherwise or if it has #LIBDLL_PIPE_STAGES stages
+ */
+__dll_inline dll_pipe_t * dll_pipe_skip(dll_pipe_t * restrict pipe, size_t count);
+
+/**
+ * \b Adds a stage to \p pipe which passes on the first \p count data it is given, and
+ * stops the traversal after them.
+ *
+ * \param pipe pipeline.
+ * \param count count of data to be passed on.
+ *
+ * \return \p pipe on success, \c NULL otherwise or if it has #LIBDLL_PIPE_STAGES stages
+ */
+__dll_inline dll_pipe_t * dll_pipe_take(dll_pipe_t * restrict pipe, size_t count);
+
+/**
+ * \b Adds a stage to \p pipe which numbers data it passes on from zero. Stages after it
+ * and terminals get these numbers as indexes instead of indexes in the list.
+ *
+ * \param pipe pipeline.
+ *
+ * \return \p pipe on success, \c NULL otherwise or if it has #LIBDLL_PIPE_STAGES stages
+ */
+__dll_inline dll_pipe_t * dll_pipe_enumerate(dll_pipe_t * restrict pipe);
+
+/**
+ * \b Runs \p pipe until the next data passes all of its stages.
+ *
+ * \param pipe pipeline.
+ * \param data receives the data.
+ * \param index receives the index of the data, may be \c NULL .
+ *
+ * \return \c true if \p data was received, \c false at the end of the pipeline
+ */
+__dll_inline bool dll_pipe_next(dll_pipe_t * restrict pipe,
+                                void ** restrict data,
+                                size_t * restrict index);
+
+/**
+ * \b Runs \p pipe to the end, calling \p fn for each data which passes all of its
+ * stages. Stops early after \p fn returns a non-zero value.
+ *
+ * \param pipe pipeline.
+ * \param fn callback-function.
+ * \param any any data to be passed to \p fn .
+ *
+ * \return count of \p fn calls.
+ */
+__dll_inline size_t dll_pipe_foreach(dll_pipe_t * restrict pipe,
+                                     dll_callback_fn_t fn,
+                                     void * restrict any);
+
+/**
+ * \b Runs \p pipe to the end, pushing each data which passes all of its stages to the
+ * end of \p out list as a new list-object.
+ *
+ * \note New list-objects don't own their data, they have no destructor. Their \c size
+ * is the size of the list-object data came from, or 0 for data produced by a map stage.
+ *
+ * \param pipe pipeline.
+ * \param out destination list.
+ *
+ * \return count of pushed list-objects.
+ */
+__dll_inline size_t dll_pipe_collect(dll_pipe_t * restrict pipe, dll_t * restrict out);
+
+/**
+ * \b Runs \p pipe to the end, folding each data which passes all of its stages into an
+ * accumulated value by \p fn .
+ *
+ * \param pipe pipeline.
+ * \param fn callback-function.
+ * \param init initial accumulated value.
+ * \param any any data to be passed to \p fn .
+ *
+ * \return the last accumulated value, \p init if no data passed.
+ */
+__dll_inline void * dll_pipe_reduce(dll_pipe_t * restrict pipe,
+                                    dll_callback_reduce_fn_t fn,
+                                    void *                   init,
+                                    void * restrict          any);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+__dll_inline dll_pipe_t dll_pipe(const dll_iterator_t * restrict it) {
+  dll_pipe_t out;
+
+  out.__obj          = NULL;
+  out.__dll          = NULL;
+  out.__index        = 0;
+  out.__done         = false;
+  out.__stages_count = 0;
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == it)) {
+    return out;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out.__obj   = it->__obj;
+  out.__dll   = it->__dll;
+  out.__index = it->__index;
+  return out;
+}
+
+/**
+ * \b Appends a stage of \p kind to \p pipe .
+ *
+ * \param pipe pipeline.
+ * \param kind kind of the stage, one of \c __DLL_PIPEI_* .
+ * \param any any data to be passed to a callback-function of the stage.
+ * \param n initial count of the stage.
+ *
+ * \return new stage with no callback-functions, \c NULL if \p pipe is full.
+ */
+__dll_inline dll_pipe_stage_t *
+    __dll_pipei_add(dll_pipe_t * restrict pipe, int kind, void * restrict any, size_t n) {
+  if (__dll_unlikely(LIBDLL_PIPE_STAGES == pipe->__stages_count)) {
+    return NULL;
+  }
+
+  dll_pipe_stage_t * restrict stage = &pipe->__stages[pipe->__stages_count++];
+
+  stage->__kind   = kind;
+  stage->__filter = NULL;
+  stage->__mapper = NULL;
+  stage->__any    = any;
+  stage->__n      = n;
+  return stage;
+}
+
+__dll_inline dll_pipe_t * dll_pipe_filter(dll_pipe_t * restrict pipe,
+                                          dll_callback_fn_t fn_cmp,
+                                          void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == fn_cmp)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_pipe_stage_t * restrict stage = __dll_pipei_add(pipe, __DLL_PIPEI_FILTER, any, 0);
+
+  if (__dll_unlikely(NULL == stage)) {
+    return NULL;
+  }
+  stage->__filter = fn_cmp;
+  return pipe;
+}
+
+__dll_inline dll_pipe_t * dll_pipe_map(dll_pipe_t * restrict pipe,
+                                       dll_callback_mapper_fn_t mapper,
+                                       void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == mapper)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_pipe_stage_t * restrict stage = __dll_pipei_add(pipe, __DLL_PIPEI_MAP, any, 0);
+
+  if (__dll_unlikely(NULL == stage)) {
+    return NULL;
+  }
+  stage->__mapper = mapper;
+  return pipe;
+}
+
+__dll_inline dll_pipe_t * dll_pipe_skip(dll_pipe_t * restrict pipe, size_t count) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_pipei_add(pipe, __DLL_PIPEI_SKIP, NULL, count) ? pipe : NULL;
+}
+
+__dll_inline dll_pipe_t * dll_pipe_take(dll_pipe_t * restrict pipe, size_t count) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  if (__dll_unlikely(NULL == __dll_pipei_add(pipe, __DLL_PIPEI_TAKE, NULL, count))) {
+    return NULL;
+  }
+  // nothing is ever taken, so the traversal doesn't even start
+  if (0 == count) {
+    pipe->__done = true;
+  }
+  return pipe;
+}
+
+__dll_inline dll_pipe_t * dll_pipe_enumerate(dll_pipe_t * restrict pipe) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return __dll_pipei_add(pipe, __DLL_PIPEI_ENUMERATE, NULL, 0) ? pipe : NULL;
+}
+
+/**
+ * \b Walks the list of \p pipe until the data of a list-object passes all of its
+ * stages.
+ *
+ * \param pipe pipeline.
+ * \param data receives the data.
+ * \param size receives the size of the list-object, 0 after a map stage.
+ * \param index receives the index of the data.
+ *
+ * \return \c true if \p data was received, \c false at the end of the pipeline
+ */
+__dll_inline bool __dll_pipei_next(dll_pipe_t * restrict pipe,
+                                   void ** restrict data,
+                                   size_t * restrict size,
+                                   size_t * restrict index) {
+  const dll_t * restrict dll   = pipe->__dll;
+  dll_obj_t * restrict   iobj  = pipe->__obj;
+  bool                   found = false;
+  size_t                 walked;
+
+  for (walked = 0; !found && !pipe->__done && iobj; ++walked) {
+    void * restrict idata  = iobj->data;
+    size_t          isize  = iobj->size;
+    size_t          iindex = pipe->__index++;
+
+    found = true;
+    for (size_t s = 0; found && pipe->__stages_count > s; ++s) {
+      dll_pipe_stage_t * restrict stage = &pipe->__stages[s];
+
+      switch (stage->__kind) {
+      case __DLL_PIPEI_FILTER:
+        found = 0 == stage->__filter(idata, stage->__any, iindex);
+        break;
+      case __DLL_PIPEI_MAP:
+        idata = stage->__mapper(idata, stage->__any, iindex);
+        isize = 0;
+        break;
+      case __DLL_PIPEI_SKIP:
+        found = 0 == stage->__n;
+        stage->__n -= !found;
+        break;
+      case __DLL_PIPEI_TAKE:
+        // the traversal stops after the last data the stage takes, so it never gets more
+        if (0 == --stage->__n) {
+          pipe->__done = true;
+        }
+        break;
+      case __DLL_PIPEI_ENUMERATE:
+        iindex = stage->__n++;
+        break;
+      }
+    }
+
+    *data  = idata;
+    *size  = isize;
+    *index = iindex;
+    iobj   = __dlli_next(dll, iobj);
+  }
+
+  pipe->__obj = iobj;
+  if (walked) {
+    __dlli_stat(dll, steps, walked);
+  }
+
+  return found;
+}
+
+__dll_inline bool dll_pipe_next(dll_pipe_t * restrict pipe,
+                                void ** restrict data,
+                                size_t * restrict index) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == data)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  size_t size   = 0;
+  size_t iindex = 0;
+
+  const bool __ret = __dll_pipei_next(pipe, data, &size, &iindex);
+
+  if (index) {
+    *index = iindex;
+  }
+  return __ret;
+}
+
+__dll_inline size_t dll_pipe_foreach(dll_pipe_t * restrict pipe,
+                                     dll_callback_fn_t fn,
+                                     void * restrict any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == fn)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  void * data   = NULL;
+  size_t size   = 0;
+  size_t index  = 0;
+  size_t called = 0;
+
+  while (__dll_pipei_next(pipe, &data, &size, &index)) {
+    ++called;
+    if (fn(data, any, index)) {
+      pipe->__done = true;
+    }
+  }
+
+  return called;
+}
+
+__dll_inline size_t dll_pipe_collect(dll_pipe_t * restrict pipe, dll_t * restrict out) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == out)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  void * data   = NULL;
+  size_t size   = 0;
+  size_t index  = 0;
+  size_t pushed = 0;
+
+  while (__dll_pipei_next(pipe, &data, &size, &index)) {
+    dll_obj_t * restrict obj = dll_emplace_back(out, data, size, LIBDLL_DESTRUCTOR_NULL);
+
+    if (__dll_unlikely(NULL == obj)) {
+      break;
+    }
+    ++pushed;
+  }
+
+  return pushed;
+}
+
+__dll_inline void * dll_pipe_reduce(dll_pipe_t * restrict pipe,
+                                    dll_callback_reduce_fn_t fn,
+                                    void *                   init,
+                                    void * restrict          any) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == pipe || NULL == fn)) {
+    return init;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  void * acc   = init;
+  void * data  = NULL;
+  size_t size  = 0;
+  size_t index = 0;
+
+  while (__dll_pipei_next(pipe, &data, &size, &index)) {
+    acc = fn(acc, data, any, index);
+  }
+
+  return acc;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLLPIPE_H */
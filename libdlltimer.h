@@ -0,0 +1,515 @@
+/**
+ * \file libdlltimer.h
+ *
+ * \brief Hierarchical timer wheel built on libdll lists: O(1) schedule, cancel and
+ * reschedule, and expired timers handed over as whole chains.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLLTIMER_H
+#define LIBDLLTIMER_H
+
+#include "libdll.h"
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// libdlltimer specifications and macroses
+// ----------------------------
+//
+
+#ifndef LIBDLL_TIMER_BITS
+/**
+ * Count of bits of ticks resolved by one level of a timer wheel, every level has
+ * <tt>1 << LIBDLL_TIMER_BITS</tt> slots.
+ */
+#  define LIBDLL_TIMER_BITS 6
+#endif /* LIBDLL_TIMER_BITS */
+
+#ifndef LIBDLL_TIMER_LEVELS
+/**
+ * Count of levels of a timer wheel. Timers expiring more than
+ * <tt>1 << (LIBDLL_TIMER_BITS * LIBDLL_TIMER_LEVELS)</tt> ticks ahead wait in an overflow
+ * list, which is rechecked once per revolution of the top level.
+ */
+#  define LIBDLL_TIMER_LEVELS 6
+#endif /* LIBDLL_TIMER_LEVELS */
+
+/**
+ * Count of slots of one level of a timer wheel.
+ */
+#define LIBDLL_TIMER_SLOTS (1UL << LIBDLL_TIMER_BITS)
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * A timer structure. It is a #dll_obj_t with its expiry tick, linked to a list of the
+ * wheel slot it waits in.
+ *
+ * \typedef dll_timer_t
+ */
+typedef struct {
+  /** list-object with data and destructor of the timer. */
+  dll_obj_t obj;
+  /** a tick on which the timer expires. */
+  uint64_t expires;
+  /** a wheel slot the timer waits in, \c NULL if it was never scheduled. */
+  dll_t * __slot;
+} dll_timer_t;
+
+/**
+ * A hierarchical timer wheel structure.
+ *
+ * \note Level \c l slots hold timers expiring in less than
+ * <tt>1 << (LIBDLL_TIMER_BITS * (l + 1))</tt> ticks. When the wheel reaches the start of
+ * a level \c l slot, its timers are cascaded down to lower levels, so every timer is
+ * moved at most #LIBDLL_TIMER_LEVELS times.
+ *
+ * \typedef dll_timer_wheel_t
+ */
+typedef struct {
+  /** the last tick the wheel was advanced to. */
+  uint64_t now;
+  /** a count of pending timers. */
+  size_t objs_count;
+  /** slots of all the levels. */
+  dll_t __slots[LIBDLL_TIMER_LEVELS][LIBDLL_TIMER_SLOTS];
+  /** timers expiring beyond the top level. */
+  dll_t __overflow;
+  /** counts of pending timers on each level and in the overflow list. */
+  size_t __level_count[LIBDLL_TIMER_LEVELS + 1];
+} dll_timer_wheel_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Creates a new and empty timer wheel.
+ *
+ * \param now the current tick.
+ *
+ * \return allocated memory for new timer wheel, \c NULL otherwise
+ */
+__dll_inline dll_timer_wheel_t * dll_timer_wheel_new(uint64_t now);
+
+/**
+ * \b Creates a new timer, which isn't scheduled yet.
+ *
+ * \param data any data you want to put inside of timer.
+ * \param size a size of \p data .
+ * \param destructor \destructor_description
+ *
+ * \return allocated memory for new timer, \c NULL otherwise
+ */
+__dll_inline dll_timer_t * dll_timer_new_obj(void * restrict data,
+                                             size_t                       size,
+                                             dll_callback_destructor_fn_t destructor);
+
+/**
+ * \b Schedules \p timer to expire on the \p expires tick in O(1). A pending \p timer is
+ * rescheduled.
+ *
+ * \note Timers scheduled on a tick the wheel already reached expire on the next tick.
+ *
+ * \attention An expired timer must be unlinked from the list it was handed over to
+ * before it's scheduled again.
+ *
+ * \param wheel timer wheel.
+ * \param timer timer, pending in \p wheel or not linked anywhere.
+ * \param expires a tick on which the timer expires.
+ *
+ * \return \c true on success, \c false otherwise
+ */
+__dll_inline bool dll_timer_schedule(dll_timer_wheel_t * restrict wheel,
+                                     dll_timer_t * restrict       timer,
+                                     uint64_t                     expires);
+
+/**
+ * \b Cancels a pending \p timer in O(1), leaving it unlinked. The timer isn't freed.
+ *
+ * \param wheel timer wheel.
+ * \param timer timer.
+ *
+ * \return \c true if \p timer was pending, \c false otherwise
+ */
+__dll_inline bool dll_timer_cancel(dll_timer_wheel_t * restrict wheel,
+                                   dll_timer_t * restrict       timer);
+
+/**
+ * \b Checks whether \p timer waits in \p wheel .
+ *
+ * \param wheel timer wheel.
+ * \param timer timer.
+ *
+ * \return \c true if \p timer is pending, \c false if it wasn't scheduled, was cancelled
+ * or expired.
+ */
+__dll_inline bool dll_timer_pending(const dll_timer_wheel_t * restrict wheel,
+                                    const dll_timer_t * restrict       timer);
+
+/**
+ * \b Advances \p wheel to the \p now tick, moving all the timers expired on the way to
+ * the end of \p expired list, in order of their expiry.
+ *
+ * \note Timers of one slot are handed over as a whole chain in O(1). Ticks on which
+ * nothing is due are skipped level by level, so advancing an idle wheel is cheap.
+ *
+ * \param wheel timer wheel.
+ * \param now the current tick, not less than the last one.
+ * \param expired list receiving expired timers as #dll_timer_t list-objects.
+ *
+ * \return count of expired timers. If the list-objects shared by a snapshot of
+ * \p expired couldn't be copied, the wheel stops before the tick of the timers it
+ * couldn't hand over, and they expire on the next call.
+ */
+__dll_inline size_t dll_timer_advance(dll_timer_wheel_t * restrict wheel,
+                                      uint64_t                     now,
+                                      dll_t * restrict             expired);
+
+/**
+ * \b Get the count of pending timers in the provided \p wheel .
+ *
+ * \param wheel timer wheel.
+ *
+ * \return count of pending timers.
+ */
+__dll_inline size_t dll_timer_wheel_size(const dll_timer_wheel_t * restrict wheel);
+
+/**
+ * \b Free the timer wheel with all its pending timers and their data.
+ *
+ * \param wheel timer wheel.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_timer_wheel_free(dll_timer_wheel_t * restrict * restrict wheel);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+__dll_inline dll_timer_wheel_t * dll_timer_wheel_new(uint64_t now) {
+  dll_timer_wheel_t * restrict out = (dll_timer_wheel_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->now = now;
+  return out;
+}
+
+__dll_inline dll_timer_t * dll_timer_new_obj(void * restrict data,
+                                             size_t                       size,
+                                             dll_callback_destructor_fn_t destructor) {
+  dll_timer_t * restrict out = (dll_timer_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->obj.data       = data;
+  out->obj.size       = size;
+  out->obj.destructor = destructor;
+  return out;
+}
+
+/**
+ * \b Computes the level of a wheel \p slot .
+ *
+ * \param wheel timer wheel.
+ * \param slot a slot of \p wheel .
+ *
+ * \return slot level, #LIBDLL_TIMER_LEVELS for the overflow list.
+ */
+__dll_inline size_t __dll_timeri_level(const dll_timer_wheel_t * restrict wheel,
+                                       const dll_t *                      slot) {
+  if (slot == &wheel->__overflow) {
+    return LIBDLL_TIMER_LEVELS;
+  }
+
+  return (size_t)(slot - &wheel->__slots[0][0]) / LIBDLL_TIMER_SLOTS;
+}
+
+/**
+ * \b Links \p timer to the slot for its \c expires tick, relative to the \p now tick.
+ *
+ * \param wheel timer wheel.
+ * \param timer unlinked timer, expiring not before \p now .
+ * \param now a tick the slot is chosen relative to.
+ */
+__dll_inline void __dll_timeri_place(dll_timer_wheel_t * restrict wheel,
+                                     dll_timer_t * restrict       timer,
+                                     uint64_t                     now) {
+  const uint64_t delta = timer->expires - now;
+  size_t         level = 0;
+
+  while (LIBDLL_TIMER_LEVELS > level && (delta >> (LIBDLL_TIMER_BITS * (level + 1)))) {
+    ++level;
+  }
+
+  if (LIBDLL_TIMER_LEVELS == level) {
+    timer->__slot = &wheel->__overflow;
+  } else {
+    const size_t shift = LIBDLL_TIMER_BITS * level;
+    const size_t i     = (timer->expires >> shift) & (LIBDLL_TIMER_SLOTS - 1);
+
+    timer->__slot = &wheel->__slots[level][i];
+  }
+
+  dll_push_back(timer->__slot, &timer->obj);
+  ++wheel->__level_count[level];
+}
+
+/**
+ * \b Moves all the list-objects of \p src to the end of \p dst in O(1), or in O(n)
+ * with #LIBDLL_MEMORY while some of them live in storage blocks.
+ *
+ * \param dst destination list.
+ * \param src source list, it's empty after the call.
+ *
+ * \return \c false if the newest snapshot of \p dst couldn't be copied, then \p src
+ * keeps its list-objects, \c true otherwise
+ */
+__dll_inline bool __dll_timeri_append(dll_t * restrict dst, dll_t * restrict src) {
+  if (__dll_unlikely(!__dlli_normalize(dst) || !__dlli_cow(src))) {
+    return false;
+  }
+
+  dll_obj_t *  last  = NULL;
+  const size_t count = src->objs_count;
+#ifdef LIBDLL_MEMORY
+  const size_t data_bytes = src->__data_bytes;
+  const size_t block_objs = src->__block_objs;
+#endif /* LIBDLL_MEMORY */
+  dll_obj_t * first = __dlli_detach(src, &last);
+
+  __dlli_stat(src, ops, 1);
+  if (NULL == first) {
+    return true;
+  }
+
+  __dlli_probe_arg(push_back_entry, dst, first);
+  __dlli_skip_drop(dst);
+  __dlli_fp_stale(dst);
+
+  if (dst->tail) {
+    dst->tail->next = first;
+    first->prev     = dst->tail;
+  } else {
+    dst->head = first;
+  }
+  dst->tail = last;
+  dst->objs_count += count;
+#ifdef LIBDLL_MEMORY
+  if (block_objs) {
+    // storage blocks are accounted one list-object at a time
+    for (dll_obj_t * iobj = first; iobj; iobj = iobj->next) {
+      __dlli_mem_link(dst, iobj);
+    }
+  } else {
+    dst->__data_bytes += data_bytes;
+  }
+#endif /* LIBDLL_MEMORY */
+  __dlli_stat(dst, ops, 1);
+  __dlli_stat_len(dst);
+  __dlli_probe_arg(push_back_return, dst, first);
+  return true;
+}
+
+/**
+ * \b Relinks all the timers of a \p slot relative to the \p now tick, cascading them
+ * down to lower levels.
+ *
+ * \param wheel timer wheel.
+ * \param slot a slot of \p wheel .
+ * \param now the tick being processed.
+ */
+__dll_inline void __dll_timeri_cascade(dll_timer_wheel_t * restrict wheel,
+                                       dll_t * restrict             slot,
+                                       uint64_t                     now) {
+  dll_obj_t * last = NULL;
+
+  wheel->__level_count[__dll_timeri_level(wheel, slot)] -= slot->objs_count;
+  for (dll_obj_t * iobj = __dlli_detach(slot, &last); iobj;) {
+    dll_obj_t * save = iobj->next;
+
+    __dll_timeri_place(wheel, (dll_timer_t *)iobj, now);
+    iobj = save;
+  }
+}
+
+__dll_inline bool dll_timer_schedule(dll_timer_wheel_t * restrict wheel,
+                                     dll_timer_t * restrict       timer,
+                                     uint64_t                     expires) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == wheel || NULL == timer)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_timer_cancel(wheel, timer);
+
+  timer->expires = expires > wheel->now ? expires : wheel->now + 1;
+  __dll_timeri_place(wheel, timer, wheel->now);
+  ++wheel->objs_count;
+
+  return true;
+}
+
+__dll_inline bool dll_timer_cancel(dll_timer_wheel_t * restrict wheel,
+                                   dll_timer_t * restrict       timer) {
+  if (false == dll_timer_pending(wheel, timer)) {
+    return false;
+  }
+
+  dll_unlink(timer->__slot, &timer->obj);
+  --wheel->__level_count[__dll_timeri_level(wheel, timer->__slot)];
+  --wheel->objs_count;
+  timer->__slot = NULL;
+
+  return true;
+}
+
+__dll_inline bool dll_timer_pending(const dll_timer_wheel_t * restrict wheel,
+                                    const dll_timer_t * restrict       timer) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == wheel || NULL == timer)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  // expired timers keep their slot, but they never expire later than the wheel is
+  return NULL != timer->__slot && timer->expires > wheel->now;
+}
+
+__dll_inline size_t dll_timer_advance(dll_timer_wheel_t * restrict wheel,
+                                      uint64_t                     now,
+                                      dll_t * restrict             expired) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == wheel || NULL == expired)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const size_t pending   = wheel->objs_count;
+  const size_t top_shift = LIBDLL_TIMER_BITS * (LIBDLL_TIMER_LEVELS - 1);
+
+  while (wheel->now < now) {
+    if (0 == wheel->objs_count) {
+      wheel->now = now;
+      break;
+    }
+
+    // nothing happens until the next start of a slot on the lowest non-empty level
+    size_t empty = 0;
+    while (LIBDLL_TIMER_LEVELS - 1 > empty && 0 == wheel->__level_count[empty]) {
+      ++empty;
+    }
+
+    const size_t   shift = LIBDLL_TIMER_BITS * empty;
+    const uint64_t tick  = ((wheel->now >> shift) + 1) << shift;
+
+    if (tick > now) {
+      wheel->now = now;
+      break;
+    }
+    wheel->now = tick;
+
+    // cascade top-down, so timers are never relinked into a slot being cascaded
+    for (size_t l = LIBDLL_TIMER_LEVELS - 1; l; --l) {
+      const size_t l_shift = LIBDLL_TIMER_BITS * l;
+
+      if (0 == (tick & ((UINT64_C(1) << l_shift) - 1))) {
+        const size_t i = (tick >> l_shift) & (LIBDLL_TIMER_SLOTS - 1);
+
+        __dll_timeri_cascade(wheel, &wheel->__slots[l][i], tick);
+      }
+    }
+    if (0 == (tick & ((UINT64_C(1) << top_shift) - 1))) {
+      __dll_timeri_cascade(wheel, &wheel->__overflow, tick);
+    }
+
+    dll_t * restrict slot  = &wheel->__slots[0][tick & (LIBDLL_TIMER_SLOTS - 1)];
+    const size_t     count = slot->objs_count;
+
+    // the timers stay in their slot, and the next advance takes this tick again
+    if (__dll_unlikely(!__dll_timeri_append(expired, slot))) {
+      wheel->now = tick - 1;
+      break;
+    }
+    wheel->__level_count[0] -= count;
+    wheel->objs_count -= count;
+  }
+
+  return pending - wheel->objs_count;
+}
+
+__dll_inline size_t dll_timer_wheel_size(const dll_timer_wheel_t * restrict wheel) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == wheel)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return wheel->objs_count;
+}
+
+__dll_inline bool dll_timer_wheel_free(dll_timer_wheel_t * restrict * restrict wheel) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == wheel || NULL == *wheel)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  for (size_t l = 0; LIBDLL_TIMER_LEVELS > l; ++l) {
+    for (size_t i = 0; LIBDLL_TIMER_SLOTS > i; ++i) {
+      dll_clear(&(*wheel)->__slots[l][i]);
+    }
+  }
+  dll_clear(&(*wheel)->__overflow);
+
+  free(*wheel);
+  *wheel = NULL;
+
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLLTIMER_H */
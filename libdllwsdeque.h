@@ -0,0 +1,428 @@
+/**
+ * \file libdllwsdeque.h
+ *
+ * \brief Work-stealing deque of list-objects: the owner pushes and pops the bottom end
+ * without read-modify-write atomics, thieves steal from the top end.
+ *
+ * Copyright (C) 2020 Taras Maliukh
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIBDLLWSDEQUE_H
+#define LIBDLLWSDEQUE_H
+
+#include "libdll.h"
+
+#ifdef __cplusplus
+/* C++ has no restrict keyword, it's undefined back at the end of this header */
+#  define restrict __restrict__
+extern "C" {
+#endif /* __cplusplus */
+
+//
+// ----------------------------
+// libdllwsdeque specifications and macroses
+// ----------------------------
+//
+
+#ifndef LIBDLL_WSDEQUE_CAPACITY
+/**
+ * Initial capacity of a work-stealing deque, a power of 2. Deques grow twice when full.
+ */
+#  define LIBDLL_WSDEQUE_CAPACITY 256
+#endif /* LIBDLL_WSDEQUE_CAPACITY */
+
+#ifndef LIBDLL_CACHE_LINE
+/**
+ * Size of a cache line, used to keep the ends of a deque written by different threads
+ * apart.
+ */
+#  define LIBDLL_CACHE_LINE 64
+#endif /* LIBDLL_CACHE_LINE */
+
+//
+// ----------------------------
+// Data structure definitions
+// ----------------------------
+//
+
+/**
+ * A circular buffer of list-objects pointers of a work-stealing deque.
+ *
+ * \typedef dll_wsdeque_buf_t
+ */
+typedef struct __s_dll_wsdeque_buf {
+  /** capacity of the buffer minus one. */
+  size_t __mask;
+  /** a buffer replaced by this one, kept until the deque is freed. */
+  struct __s_dll_wsdeque_buf * __prev;
+  /** list-objects pointers. */
+  dll_obj_t * __objs[];
+} dll_wsdeque_buf_t;
+
+/**
+ * A work-stealing deque structure, Chase-Lev deque of #dll_obj_t pointers.
+ *
+ * \note Only one thread, the owner, may call #dll_wsdeque_push and #dll_wsdeque_pop ,
+ * any count of threads may call #dll_wsdeque_steal and #dll_wsdeque_steal_half at the
+ * same time.
+ *
+ * \note List-objects aren't linked while they are in the deque, so they may be taken
+ * from and handed over to any #dll_t list.
+ *
+ * \typedef dll_wsdeque_t
+ */
+typedef struct {
+  /** index of the next list-object to steal, advanced by thieves. */
+  int64_t __top;
+  /** keeps the ends written by thieves and by the owner on different cache lines. */
+  char __pad_top[LIBDLL_CACHE_LINE - sizeof(int64_t)];
+  /** index after the last list-object pushed, written by the owner only. */
+  int64_t __bottom;
+  /** the current buffer. */
+  dll_wsdeque_buf_t * __buf;
+} dll_wsdeque_t;
+
+//
+// ----------------------------
+// Function prototypes
+// ----------------------------
+//
+
+/**
+ * \b Creates a new and empty work-stealing deque.
+ *
+ * \return allocated memory for new deque, \c NULL otherwise
+ */
+__dll_inline dll_wsdeque_t * dll_wsdeque_new(void);
+
+/**
+ * \b Pushes \p obj to the bottom of \p deque . Owner only.
+ *
+ * \note Doesn't use read-modify-write atomics, only grows the buffer when it's full.
+ *
+ * \param deque work-stealing deque.
+ * \param obj unlinked list-object.
+ *
+ * \return \p obj on success, \c NULL otherwise
+ */
+__dll_inline dll_obj_t * dll_wsdeque_push(dll_wsdeque_t * restrict deque,
+                                          dll_obj_t * restrict     obj);
+
+/**
+ * \b Pops the last pushed list-object from the bottom of \p deque . Owner only.
+ *
+ * \note Doesn't use read-modify-write atomics unless \p deque holds just one list-object,
+ * which the owner may race for with thieves.
+ *
+ * \param deque work-stealing deque.
+ *
+ * \return list-object, \c NULL if \p deque is empty.
+ */
+__dll_inline dll_obj_t * dll_wsdeque_pop(dll_wsdeque_t * restrict deque);
+
+/**
+ * \b Steals the first pushed list-object from the top of \p deque . Any thread.
+ *
+ * \param deque work-stealing deque.
+ *
+ * \return list-object, \c NULL if \p deque is empty or the race for the list-object was
+ * lost to other thread.
+ */
+__dll_inline dll_obj_t * dll_wsdeque_steal(dll_wsdeque_t * restrict deque);
+
+/**
+ * \b Steals half of the list-objects of \p deque , rounded up, from its top and links
+ * them as a chain to the end of \p out list, oldest first. Any thread.
+ *
+ * \note List-objects are claimed one by one, so the owner keeps its fast path. Stealing
+ * stops early when a race is lost.
+ *
+ * \param deque work-stealing deque.
+ * \param out list owned by the calling thread.
+ *
+ * \return count of stolen list-objects, 0 if the list-objects shared by a snapshot of
+ * \p out couldn't be copied, then nothing is stolen.
+ */
+__dll_inline size_t dll_wsdeque_steal_half(dll_wsdeque_t * restrict deque,
+                                           dll_t * restrict         out);
+
+/**
+ * \b Get the count of list-objects in \p deque . Only exact when other threads don't
+ * touch \p deque at the moment.
+ *
+ * \param deque work-stealing deque.
+ *
+ * \return count of list-objects.
+ */
+__dll_inline size_t dll_wsdeque_size(const dll_wsdeque_t * restrict deque);
+
+/**
+ * \b Free the work-stealing deque and the remaining list-objects with their data. No
+ * other thread may use \p deque .
+ *
+ * \param deque work-stealing deque.
+ *
+ * \return true on success, false otherwise
+ */
+__dll_inline bool dll_wsdeque_free(dll_wsdeque_t * restrict * restrict deque);
+
+/*
+ * ----------------------------
+ * Function definitions
+ * ----------------------------
+ */
+
+/**
+ * \b Allocates a buffer of \p capacity list-objects pointers.
+ *
+ * \param capacity a power of 2.
+ *
+ * \return allocated buffer, \c NULL otherwise
+ */
+__dll_inline dll_wsdeque_buf_t * __dll_wsdequei_buf_new(size_t capacity) {
+  dll_wsdeque_buf_t * restrict out =
+      (dll_wsdeque_buf_t *)malloc(sizeof(*out) + capacity * sizeof(*out->__objs));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->__mask = capacity - 1;
+  out->__prev = NULL;
+  return out;
+}
+
+/**
+ * \b Replaces the buffer of \p deque with one twice as big, copying list-objects from
+ * \p top to \p bottom . The old buffer is kept, thieves may still read it.
+ *
+ * \param deque work-stealing deque.
+ * \param top the top index.
+ * \param bottom the bottom index.
+ *
+ * \return the new buffer, \c NULL otherwise
+ */
+__dll_inline dll_wsdeque_buf_t * __dll_wsdequei_grow(dll_wsdeque_t * restrict deque,
+                                                     int64_t                  top,
+                                                     int64_t                  bottom) {
+  dll_wsdeque_buf_t * restrict old = deque->__buf;
+  dll_wsdeque_buf_t * restrict out = __dll_wsdequei_buf_new((old->__mask + 1) << 1);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  for (int64_t i = top; bottom > i; ++i) {
+    out->__objs[(size_t)i & out->__mask] = old->__objs[(size_t)i & old->__mask];
+  }
+  out->__prev = old;
+
+  __atomic_store_n(&deque->__buf, out, __ATOMIC_RELEASE);
+  return out;
+}
+
+__dll_inline dll_wsdeque_t * dll_wsdeque_new(void) {
+  dll_wsdeque_t * restrict out = (dll_wsdeque_t *)calloc(1, sizeof(*out));
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  out->__buf = __dll_wsdequei_buf_new(LIBDLL_WSDEQUE_CAPACITY);
+
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == out->__buf)) {
+    free(out);
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  return out;
+}
+
+__dll_inline dll_obj_t * dll_wsdeque_push(dll_wsdeque_t * restrict deque,
+                                          dll_obj_t * restrict     obj) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque || NULL == obj)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const int64_t bottom = __atomic_load_n(&deque->__bottom, __ATOMIC_RELAXED);
+  const int64_t top    = __atomic_load_n(&deque->__top, __ATOMIC_ACQUIRE);
+  dll_wsdeque_buf_t * restrict buf = __atomic_load_n(&deque->__buf, __ATOMIC_RELAXED);
+
+  if (__dll_unlikely((size_t)(bottom - top) > buf->__mask)) {
+#ifndef LIBDLL_UNSAFE_USAGE
+    if (__dll_unlikely(NULL == (buf = __dll_wsdequei_grow(deque, top, bottom)))) {
+      return NULL;
+    }
+#else
+    buf = __dll_wsdequei_grow(deque, top, bottom);
+#endif /* LIBDLL_UNSAFE_USAGE */
+  }
+
+  obj->next = obj->prev = NULL;
+  __atomic_store_n(&buf->__objs[(size_t)bottom & buf->__mask], obj, __ATOMIC_RELAXED);
+  __atomic_store_n(&deque->__bottom, bottom + 1, __ATOMIC_RELEASE);
+
+  return obj;
+}
+
+__dll_inline dll_obj_t * dll_wsdeque_pop(dll_wsdeque_t * restrict deque) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const int64_t bottom = __atomic_load_n(&deque->__bottom, __ATOMIC_RELAXED) - 1;
+  dll_wsdeque_buf_t * restrict buf = __atomic_load_n(&deque->__buf, __ATOMIC_RELAXED);
+
+  __atomic_store_n(&deque->__bottom, bottom, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  int64_t     top   = __atomic_load_n(&deque->__top, __ATOMIC_RELAXED);
+  dll_obj_t * __ret = NULL;
+
+  if (__dll_likely(top <= bottom)) {
+    __ret = __atomic_load_n(&buf->__objs[(size_t)bottom & buf->__mask], __ATOMIC_RELAXED);
+    if (top == bottom) {
+      // the last list-object, thieves may race for it
+      if (!__atomic_compare_exchange_n(&deque->__top,
+                                       &top,
+                                       top + 1,
+                                       false,
+                                       __ATOMIC_SEQ_CST,
+                                       __ATOMIC_RELAXED)) {
+        __ret = NULL;
+      }
+      __atomic_store_n(&deque->__bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+  } else {
+    __atomic_store_n(&deque->__bottom, bottom + 1, __ATOMIC_RELAXED);
+  }
+
+  return __ret;
+}
+
+__dll_inline dll_obj_t * dll_wsdeque_steal(dll_wsdeque_t * restrict deque) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque)) {
+    return NULL;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  int64_t top = __atomic_load_n(&deque->__top, __ATOMIC_ACQUIRE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  const int64_t bottom = __atomic_load_n(&deque->__bottom, __ATOMIC_ACQUIRE);
+
+  if (top >= bottom) {
+    return NULL;
+  }
+
+  dll_wsdeque_buf_t * restrict buf = __atomic_load_n(&deque->__buf, __ATOMIC_ACQUIRE);
+  dll_obj_t * __ret =
+      __atomic_load_n(&buf->__objs[(size_t)top & buf->__mask], __ATOMIC_RELAXED);
+
+  if (!__atomic_compare_exchange_n(
+          &deque->__top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+    return NULL;
+  }
+
+  return __ret;
+}
+
+__dll_inline size_t dll_wsdeque_steal_half(dll_wsdeque_t * restrict deque,
+                                           dll_t * restrict         out) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque || NULL == out)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const int64_t top    = __atomic_load_n(&deque->__top, __ATOMIC_ACQUIRE);
+  const int64_t bottom = __atomic_load_n(&deque->__bottom, __ATOMIC_ACQUIRE);
+  size_t        __ret  = 0;
+
+  // after this no push below can fail, so no stolen list-object is lost
+  if (top >= bottom || __dll_unlikely(!__dlli_cow(out))) {
+    return 0;
+  }
+
+  for (size_t half = (size_t)(bottom - top + 1) >> 1; half > __ret; ++__ret) {
+    dll_obj_t * restrict obj = dll_wsdeque_steal(deque);
+
+    if (NULL == obj) {
+      break;
+    }
+    dll_push_back(out, obj);
+  }
+
+  return __ret;
+}
+
+__dll_inline size_t dll_wsdeque_size(const dll_wsdeque_t * restrict deque) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque)) {
+    return 0;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  const int64_t bottom = __atomic_load_n(&deque->__bottom, __ATOMIC_ACQUIRE);
+  const int64_t top    = __atomic_load_n(&deque->__top, __ATOMIC_ACQUIRE);
+
+  return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+__dll_inline bool dll_wsdeque_free(dll_wsdeque_t * restrict * restrict deque) {
+#ifndef LIBDLL_UNSAFE_USAGE
+  if (__dll_unlikely(NULL == deque || NULL == *deque)) {
+    return false;
+  }
+#endif /* LIBDLL_UNSAFE_USAGE */
+
+  dll_wsdeque_buf_t * restrict buf = (*deque)->__buf;
+
+  for (int64_t i = (*deque)->__top; (*deque)->__bottom > i; ++i) {
+    __dlli_destroy_obj(buf->__objs[(size_t)i & buf->__mask]);
+  }
+
+  while (buf) {
+    dll_wsdeque_buf_t * restrict save = buf->__prev;
+
+    free(buf);
+    buf = save;
+  }
+
+  free(*deque);
+  *deque = NULL;
+
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#  undef restrict
+#endif /* __cplusplus */
+
+#endif /* LIBDLLWSDEQUE_H */
@@ -0,0 +1,102 @@
+/**
+ * \file test.h
+ *
+ * \brief Checking helpers shared by libdll tests.
+ *
+ * A failed check prints its location and expression, and the test goes on with the next
+ * one. #test_result is the exit status of the test.
+ */
+
+#ifndef LIBDLL_TEST_H
+#define LIBDLL_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../libdll.h"
+
+/** count of failed checks of the test. */
+static size_t test_failures;
+
+/**
+ * \b Checks that \p _cond holds, reporting it as a failure otherwise.
+ */
+#define TEST_CHECK(_cond)                                                                \
+  do {                                                                                   \
+    if (!(_cond)) {                                                                      \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond);          \
+      ++test_failures;                                                                   \
+    }                                                                                    \
+  } while (0)
+
+/**
+ * \b Exit status of the test: 0 if every check passed.
+ */
+static inline int test_result(void) {
+  if (test_failures) {
+    fprintf(stderr, "%zu checks failed\n", test_failures);
+  }
+  return test_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * \b Compares two \c int data, as a #dll_callback_ext_fn_t .
+ */
+static inline ssize_t test_cmp_int(void * a, void * b, void * any, size_t index) {
+  (void)any;
+  (void)index;
+  return (*(int *)a > *(int *)b) - (*(int *)a < *(int *)b);
+}
+
+/**
+ * \b Appends a copy of \p value to \p dll , owned by the list.
+ */
+static inline dll_obj_t * test_push_int(dll_t * dll, int value) {
+  int * data = (int *)malloc(sizeof(*data));
+
+  *data = value;
+  return dll_emplace_back(dll, data, sizeof(*data), LIBDLL_DESTRUCTOR_DEFAULT);
+}
+
+/**
+ * \b Creates a list of copies of \p n \p values .
+ */
+static inline dll_t * test_list_of(const int * values, size_t n) {
+  dll_t * dll = dll_new();
+
+  for (size_t i = 0; n > i; ++i) {
+    test_push_int(dll, values[i]);
+  }
+  return dll;
+}
+
+/**
+ * \b Checks that \p dll holds exactly \p n \p values in this order, walking it forth and
+ * back.
+ */
+static inline bool test_list_is(dll_t * dll, const int * values, size_t n) {
+  dll_iterator_t it = dll_iterator(dll);
+  size_t         i  = 0;
+
+  if (n != dll->objs_count) {
+    return false;
+  }
+  for (; n > i && dll_iterator_get_obj(&it); ++i, dll_next(&it)) {
+    if (values[i] != *(int *)dll_iterator_get_data(&it)) {
+      return false;
+    }
+  }
+  if (n != i || dll_iterator_get_obj(&it)) {
+    return false;
+  }
+
+  it = dll_back(dll);
+  for (; i && dll_iterator_get_obj(&it); --i, dll_prev(&it)) {
+    if (values[i - 1] != *(int *)dll_iterator_get_data(&it)) {
+      return false;
+    }
+  }
+  return 0 == i && NULL == dll_iterator_get_obj(&it);
+}
+
+#endif /* LIBDLL_TEST_H */
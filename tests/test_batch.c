@@ -0,0 +1,121 @@
+/**
+ * \file test_batch.c
+ *
+ * \brief #dll_foreach_batch , #dll_find_batch and #dll_remove_batch hand the data of a
+ * list over in order, in batches of up to #LIBDLL_BATCH_SIZE , with the index of each
+ * batch, also after #dll_reverse .
+ */
+
+#include "test.h"
+
+/**
+ * Order of the data handed over by batch callbacks.
+ */
+typedef struct {
+  /** value expected next. */
+  int next;
+  /** step between values. */
+  int step;
+  /** index expected for the next batch. */
+  size_t index;
+  /** count of callback calls. */
+  size_t calls;
+  /** count of batches smaller than #LIBDLL_BATCH_SIZE . */
+  size_t partial;
+  /** \c true while every batch came in order. */
+  bool ordered;
+} batch_order_t;
+
+static void check_order(batch_order_t * order,
+                        void **         objs_data,
+                        size_t          count,
+                        size_t          index) {
+  order->ordered &= order->index == index && 0 < count && LIBDLL_BATCH_SIZE >= count;
+  for (size_t j = 0; count > j; ++j, order->next += order->step) {
+    order->ordered &= order->next == *(int *)objs_data[j];
+  }
+  order->index += count;
+  order->partial += LIBDLL_BATCH_SIZE != count;
+  ++order->calls;
+}
+
+static void visit(void ** restrict objs_data,
+                  ssize_t * restrict results,
+                  size_t count,
+                  void * restrict any,
+                  size_t index) {
+  (void)results;
+  check_order((batch_order_t *)any, objs_data, count, index);
+}
+
+static void is_37(void ** restrict objs_data,
+                  ssize_t * restrict results,
+                  size_t count,
+                  void * restrict any,
+                  size_t index) {
+  (void)index;
+  ++*(size_t *)any;
+  for (size_t j = 0; count > j; ++j) {
+    results[j] = 37 != *(int *)objs_data[j];
+  }
+}
+
+static void is_multiple_of_3(void ** restrict objs_data,
+                             ssize_t * restrict results,
+                             size_t count,
+                             void * restrict any,
+                             size_t index) {
+  check_order((batch_order_t *)any, objs_data, count, index);
+  for (size_t j = 0; count > j; ++j) {
+    results[j] = *(int *)objs_data[j] % 3;
+  }
+}
+
+int main(void) {
+  const size_t n   = 2 * LIBDLL_BATCH_SIZE + LIBDLL_BATCH_SIZE / 2;
+  dll_t *      dll = dll_new();
+
+  for (size_t i = 0; n > i; ++i) {
+    test_push_int(dll, (int)i);
+  }
+
+  batch_order_t order = {0, 1, 0, 0, 0, true};
+
+  TEST_CHECK(dll_foreach_batch(dll, visit, &order));
+  TEST_CHECK(order.ordered && 3 == order.calls && 1 == order.partial);
+  TEST_CHECK(n == order.index);
+
+  // the search stops at the batch holding the match
+  size_t calls = 0;
+  int *  found = (int *)dll_find_batch(dll, is_37, &calls);
+
+  TEST_CHECK(found && 37 == *found);
+  TEST_CHECK(37 / LIBDLL_BATCH_SIZE + 1 == calls);
+
+  dll_t * few = test_list_of((const int[]){1, 2, 3}, 3);
+
+  calls = 0;
+  TEST_CHECK(NULL == dll_find_batch(few, is_37, &calls) && 1 == calls);
+  dll_free(&few);
+
+  // batches follow the list backwards after a reverse
+  dll_t * reversed = dll_new();
+
+  for (size_t i = 0; n > i; ++i) {
+    test_push_int(reversed, (int)i);
+  }
+  TEST_CHECK(dll_reverse(reversed));
+  order = (batch_order_t){(int)n - 1, -1, 0, 0, 0, true};
+  TEST_CHECK(dll_foreach_batch(reversed, visit, &order));
+  TEST_CHECK(order.ordered && n == order.index);
+
+  order = (batch_order_t){(int)n - 1, -1, 0, 0, 0, true};
+  TEST_CHECK((n + 2) / 3 == dll_remove_batch(reversed, is_multiple_of_3, &order));
+  TEST_CHECK(order.ordered && n - (n + 2) / 3 == reversed->objs_count);
+  found = (int *)dll_find_batch(reversed, is_37, &calls);
+  TEST_CHECK(found && 37 == *found);
+
+  dll_free(&dll);
+  dll_free(&reversed);
+  return test_result();
+}
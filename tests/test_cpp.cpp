@@ -0,0 +1,93 @@
+/**
+ * \file test_cpp.cpp
+ *
+ * \brief #libdll::list sorts keep the bookkeeping of #dll_sort : the fingerprint of
+ * #LIBDLL_FINGERPRINT builds and the operations count of #LIBDLL_STATS builds. Built as
+ * C++17 too, for the execution policy overloads.
+ */
+
+#include "test.h"
+
+#include "../libdll.hpp"
+
+#include <stdexcept>
+
+#ifdef __cpp_lib_execution
+/**
+ * \b Checks #libdll::list::sort and #libdll::list::for_each with execution policies.
+ */
+static void test_policies() {
+  libdll::list<int> list;
+  libdll::list<int> sorted;
+
+  for (int value : {5, 3, 9, 1, 7, 3}) {
+    list.push_back(value);
+  }
+  for (int value : {1, 3, 3, 5, 7, 9}) {
+    sorted.push_back(value);
+  }
+
+  const size_t ops = list.get()->stats.ops;
+
+  list.sort(std::execution::par);
+  TEST_CHECK(ops + 1 == list.get()->stats.ops);
+  TEST_CHECK(dll_is_equal(list.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+  TEST_CHECK(1 == list.front() && 9 == list.back());
+
+  list.reverse();
+  list.sort(std::execution::seq, [](int a, int b) { return a > b; });
+  list.reverse();
+  TEST_CHECK(dll_is_equal(list.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+
+  list.for_each(std::execution::par, [](int & v) { v *= 2; });
+  dll_fingerprint_invalidate(list.get());
+
+  int expected = 0;
+  for (int value : {1, 3, 3, 5, 7, 9}) {
+    expected += 2 * value;
+  }
+  for (int value : list) {
+    expected -= value;
+  }
+  TEST_CHECK(0 == expected);
+}
+#endif /* __cpp_lib_execution */
+
+int main() {
+  libdll::list<int> unsorted;
+  libdll::list<int> sorted;
+
+  for (int value : {3, 1, 2}) {
+    unsorted.push_back(value);
+  }
+  for (int value : {1, 2, 3}) {
+    sorted.push_back(value);
+  }
+  TEST_CHECK(!dll_is_equal(unsorted.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+
+  const size_t ops = unsorted.get()->stats.ops;
+
+  unsorted.sort();
+  TEST_CHECK(ops + 1 == unsorted.get()->stats.ops);
+  TEST_CHECK(dll_is_equal(unsorted.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+
+  unsorted.sort([](int a, int b) { return a > b; });
+  TEST_CHECK(ops + 2 == unsorted.get()->stats.ops);
+  TEST_CHECK(!dll_is_equal(unsorted.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+  unsorted.reverse();
+  TEST_CHECK(dll_is_equal(unsorted.get(), sorted.get(), LIBDLL_CMP_BYTES, nullptr));
+
+  bool rejected = false;
+  try {
+    libdll::list<int> adopted(nullptr);
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  TEST_CHECK(rejected);
+
+#ifdef __cpp_lib_execution
+  test_policies();
+#endif /* __cpp_lib_execution */
+
+  return test_result();
+}
@@ -0,0 +1,128 @@
+/**
+ * \file test_dll32.c
+ *
+ * \brief Compact lists of libdll32.h keep the order of #dll_t lists through pushes,
+ * pops, inserts and unlinks, while their slab grows and reuses freed list-objects.
+ */
+
+#include "test.h"
+
+#include "../libdll32.h"
+
+/**
+ * \b Appends a copy of \p value to \p dll , owned by the list.
+ */
+static dll32_idx_t push_int(dll32_t * dll, int value) {
+  int * data = (int *)malloc(sizeof(*data));
+
+  *data = value;
+  return dll32_emplace_back(dll, data, sizeof(*data));
+}
+
+/**
+ * \b Checks that \p dll holds exactly \p n \p values in this order, walking it forth and
+ * back.
+ */
+static bool list32_is(dll32_t * dll, const int * values, size_t n) {
+  dll32_iterator_t it = dll32_front(dll);
+  size_t           i  = 0;
+
+  if (n != dll32_size(dll)) {
+    return false;
+  }
+  for (; n > i && LIBDLL32_NIL != dll32_iterator_get_obj(&it); ++i, dll32_next(&it)) {
+    if (values[i] != *(int *)dll32_iterator_get_data(&it)) {
+      return false;
+    }
+  }
+  if (n != i || LIBDLL32_NIL != dll32_iterator_get_obj(&it)) {
+    return false;
+  }
+
+  it = dll32_back(dll);
+  for (; i && LIBDLL32_NIL != dll32_iterator_get_obj(&it); --i, dll32_prev(&it)) {
+    if (values[i - 1] != *(int *)dll32_iterator_get_data(&it)) {
+      return false;
+    }
+  }
+  return 0 == i && LIBDLL32_NIL == dll32_iterator_get_obj(&it);
+}
+
+static ssize_t sum_int(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  *(long *)any += *(int *)data;
+  return 0;
+}
+
+int main(void) {
+  dll32_t * dll = dll32_new(LIBDLL_DESTRUCTOR_DEFAULT);
+
+  TEST_CHECK(dll && dll32_empty(dll));
+  TEST_CHECK(LIBDLL32_NIL == dll32_pop_front(dll));
+  TEST_CHECK(LIBDLL32_NIL == dll32_pop_back(dll));
+  TEST_CHECK(list32_is(dll, NULL, 0));
+
+  push_int(dll, 1);
+  push_int(dll, 2);
+  int * front = (int *)malloc(sizeof(*front));
+
+  *front = 0;
+  dll32_emplace_front(dll, front, sizeof(*front));
+  TEST_CHECK(list32_is(dll, (const int[]){0, 1, 2}, 3));
+
+  int * middle = (int *)malloc(sizeof(*middle));
+
+  *middle = 9;
+  dll32_idx_t nine = dll32_emplace(dll, middle, sizeof(*middle), 2);
+  TEST_CHECK(LIBDLL32_NIL != nine);
+  TEST_CHECK(list32_is(dll, (const int[]){0, 1, 9, 2}, 4));
+
+  dll32_idx_t orphan = dll32_new_obj(dll, NULL, 0);
+  TEST_CHECK(LIBDLL32_NIL == dll32_insert(dll, orphan, 5));
+  TEST_CHECK(dll32_free_obj(dll, orphan));
+
+  TEST_CHECK(nine == dll32_unlink(dll, nine));
+  TEST_CHECK(list32_is(dll, (const int[]){0, 1, 2}, 3));
+  TEST_CHECK(nine == dll32_insert(dll, nine, 3));
+  TEST_CHECK(list32_is(dll, (const int[]){0, 1, 2, 9}, 4));
+
+  dll32_idx_t popped = dll32_pop_front(dll);
+
+  TEST_CHECK(0 == *(int *)dll32_obj_get_data(dll, popped));
+  TEST_CHECK(dll32_free_obj(dll, popped));
+  popped = dll32_pop_back(dll);
+  TEST_CHECK(9 == *(int *)dll32_obj_get_data(dll, popped));
+  TEST_CHECK(dll32_free_obj(dll, popped));
+  TEST_CHECK(list32_is(dll, (const int[]){1, 2}, 2));
+
+  // freed list-objects are reused before the slab grows
+  const dll32_idx_t used = dll->used;
+
+  push_int(dll, 3);
+  push_int(dll, 4);
+  TEST_CHECK(used == dll->used);
+  TEST_CHECK(list32_is(dll, (const int[]){1, 2, 3, 4}, 4));
+
+  // indices stay valid while the slab moves
+  for (int i = 5; 10000 > i; ++i) {
+    push_int(dll, i);
+  }
+  TEST_CHECK(9999 == dll32_size(dll));
+
+  long sum = 0;
+
+  TEST_CHECK(dll32_foreach(dll, sum_int, &sum));
+  TEST_CHECK(49995000L == sum);
+  TEST_CHECK(dll32_delete(dll, dll->head));
+  TEST_CHECK(2 == *(int *)dll32_obj_get_data(dll, dll->head));
+
+  TEST_CHECK(dll32_clear(dll));
+  TEST_CHECK(dll32_empty(dll));
+  TEST_CHECK(LIBDLL32_NIL == dll32_pop_back(dll));
+  push_int(dll, 7);
+  TEST_CHECK(list32_is(dll, (const int[]){7}, 1));
+
+  TEST_CHECK(dll32_free(&dll));
+  TEST_CHECK(NULL == dll);
+  return test_result();
+}
@@ -0,0 +1,89 @@
+/**
+ * \file test_fingerprint.c
+ *
+ * \brief Fingerprints of #LIBDLL_FINGERPRINT builds match for lists of the same content,
+ * and #dll_is_equal with #LIBDLL_CMP_BYTES agrees with them after reorders.
+ */
+
+#include "test.h"
+
+/**
+ * \b Checks that the fingerprint kept by \p dll equals the one computed from scratch.
+ */
+static bool fingerprint_is_fresh(dll_t * dll) {
+  uint64_t kept     = 0;
+  uint64_t computed = 0;
+
+  if (!dll_fingerprint(dll, &kept) || !dll_fingerprint_invalidate(dll) ||
+      !dll_fingerprint(dll, &computed)) {
+    return false;
+  }
+  return kept == computed;
+}
+
+static bool same_fingerprints(dll_t * a, dll_t * b) {
+  uint64_t fp_a = 0;
+  uint64_t fp_b = 0;
+
+  return dll_fingerprint(a, &fp_a) && dll_fingerprint(b, &fp_b) && fp_a == fp_b;
+}
+
+int main(void) {
+  static const int values[] = {4, 1, 3, 0, 2};
+  dll_t *          dll      = test_list_of(values, 5);
+  dll_t *          sorted   = test_list_of((const int[]){0, 1, 2, 3, 4}, 5);
+
+  TEST_CHECK(fingerprint_is_fresh(dll));
+  TEST_CHECK(!same_fingerprints(dll, sorted));
+  TEST_CHECK(!dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+
+  // links and unlinks keep the fingerprint up to date
+  int * data = (int *)malloc(sizeof(*data));
+
+  *data = 7;
+  dll_emplace(dll, data, sizeof(*data), LIBDLL_DESTRUCTOR_DEFAULT, 2);
+  TEST_CHECK(fingerprint_is_fresh(dll));
+  TEST_CHECK(dll_delete(dll, dll->head->next->next));
+  TEST_CHECK(fingerprint_is_fresh(dll));
+
+  // neighbours aren't hashed again, the hash kept by the tail stands for its data
+  int * tail = (int *)dll->tail->data;
+
+  test_push_int(dll, 8);
+  *tail = 9;
+  TEST_CHECK(dll_delete(dll, dll->tail));
+  *tail = 2;
+  TEST_CHECK(fingerprint_is_fresh(dll));
+
+  // reorders mark it stale, so equal lists are still found equal
+  TEST_CHECK(dll_sort(dll, test_cmp_int, NULL));
+  TEST_CHECK(dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+  TEST_CHECK(same_fingerprints(dll, sorted));
+
+  TEST_CHECK(dll_nth_element(dll, 2, test_cmp_int, NULL));
+  TEST_CHECK(dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+
+  dll_reverse(dll);
+  TEST_CHECK(!dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+  TEST_CHECK(same_fingerprints(dll, sorted));
+  dll_reverse(dll);
+
+  TEST_CHECK(dll_partial_sort(dll, 2, test_cmp_int, NULL));
+  TEST_CHECK(dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+
+  // data changed in place needs an invalidation
+  *(int *)dll->tail->data = 5;
+  TEST_CHECK(dll_fingerprint_invalidate(dll));
+  TEST_CHECK(!dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+  *(int *)sorted->tail->data = 5;
+  TEST_CHECK(dll_fingerprint_invalidate(sorted));
+  TEST_CHECK(dll_is_equal(dll, sorted, LIBDLL_CMP_BYTES, NULL));
+
+  TEST_CHECK(dll_clear(dll));
+  TEST_CHECK(dll_clear(sorted));
+  TEST_CHECK(same_fingerprints(dll, sorted));
+
+  dll_free(&dll);
+  dll_free(&sorted);
+  return test_result();
+}
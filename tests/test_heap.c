@@ -0,0 +1,103 @@
+/**
+ * \file test_heap.c
+ *
+ * \brief Pairing heaps of libdllheap.h pop their list-objects in order through pushes,
+ * decrease-keys, unlinks and melds, and move them to and from lists without copies.
+ */
+
+#include "test.h"
+
+#include "../libdllheap.h"
+
+/**
+ * \b Pushes a copy of \p value to \p heap , owned by the heap.
+ */
+static dll_heap_obj_t * push_int(dll_heap_t * heap, int value) {
+  int * data = (int *)malloc(sizeof(*data));
+
+  *data = value;
+  return dll_heap_emplace(heap, data, sizeof(*data), LIBDLL_DESTRUCTOR_DEFAULT);
+}
+
+/**
+ * \b Pops the minimum of \p heap and frees it, returning its value or -1 if empty.
+ */
+static int pop_int(dll_heap_t * heap) {
+  // unsafe builds don't check for an empty heap
+  if (0 == dll_heap_size(heap)) {
+    return -1;
+  }
+
+  dll_obj_t * obj = (dll_obj_t *)dll_heap_pop(heap);
+
+  const int value = *(int *)obj->data;
+
+  dll_free_obj(&obj);
+  return value;
+}
+
+int main(void) {
+  dll_heap_t * heap = dll_heap_new(test_cmp_int, NULL);
+
+  TEST_CHECK(heap && 0 == dll_heap_size(heap));
+  TEST_CHECK(NULL == dll_heap_top(heap));
+  TEST_CHECK(-1 == pop_int(heap));
+
+  static const int values[] = {50, 30, 80, 10, 90, 20, 70, 60, 40};
+  dll_heap_obj_t * objs[9];
+
+  for (size_t i = 0; 9 > i; ++i) {
+    objs[i] = push_int(heap, values[i]);
+  }
+  TEST_CHECK(9 == dll_heap_size(heap));
+  TEST_CHECK(10 == *(int *)dll_heap_top(heap)->obj.data);
+
+  // pop once so the heap has children to cut from
+  TEST_CHECK(10 == pop_int(heap));
+  *(int *)objs[7]->obj.data = 5;
+  TEST_CHECK(dll_heap_decrease_key(heap, objs[7]));
+  TEST_CHECK(objs[7] == dll_heap_top(heap));
+
+  TEST_CHECK(objs[2] == dll_heap_unlink(heap, objs[2]));
+  TEST_CHECK(dll_heap_push(heap, objs[2]));
+  TEST_CHECK(dll_heap_delete(heap, objs[4]));
+  TEST_CHECK(7 == dll_heap_size(heap));
+
+  dll_heap_t * other = dll_heap_new(test_cmp_int, NULL);
+
+  push_int(other, 35);
+  push_int(other, 1);
+  TEST_CHECK(dll_heap_meld(heap, other));
+  TEST_CHECK(0 == dll_heap_size(other) && NULL == dll_heap_top(other));
+  TEST_CHECK(9 == dll_heap_size(heap));
+
+  dll_t * dll = dll_new();
+
+  test_push_int(dll, 0);
+  TEST_CHECK(9 == dll_heap_drain(heap, dll));
+  TEST_CHECK(0 == dll_heap_size(heap) && NULL == dll_heap_top(heap));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 5, 20, 30, 35, 40, 50, 70, 80}, 10));
+
+  // heap list-objects go back and forth, the plain one is left out of the round trip
+  dll_obj_t * plain = dll_pop_front(dll);
+
+  TEST_CHECK(dll_free_obj(&plain));
+  dll_reverse(dll);
+  TEST_CHECK(9 == dll_heap_from_list(heap, dll));
+  TEST_CHECK(test_list_is(dll, NULL, 0));
+  TEST_CHECK(1 == pop_int(heap));
+
+  // a snapshot of the destination keeps what it saw
+  test_push_int(dll, 0);
+  dll_snapshot_t * snap = dll_snapshot(dll);
+
+  TEST_CHECK(8 == dll_heap_drain(heap, dll));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 5, 20, 30, 35, 40, 50, 70, 80}, 9));
+  TEST_CHECK(1 == dll_snapshot_size(snap));
+  TEST_CHECK(dll_snapshot_free(&snap));
+
+  TEST_CHECK(dll_heap_free(&heap) && NULL == heap);
+  TEST_CHECK(dll_heap_free(&other));
+  dll_free(&dll);
+  return test_result();
+}
@@ -0,0 +1,124 @@
+/**
+ * \file test_io.c
+ *
+ * \brief Lists written one after another by #dll_serialize_fd to a pipe or a file are
+ * read back one by one by #dll_deserialize_fd , whatever the size of their payloads.
+ * Mapped list files are walked no further than their count of list-objects.
+ */
+
+#include "test.h"
+
+#include "../libdllio.h"
+
+/**
+ * \b Checks that \p dll holds \p n payloads of \p size bytes, each filled with the byte
+ * of its index.
+ */
+static bool list_of_bytes_is(const dll_t * dll, size_t n, size_t size) {
+  size_t i = 0;
+
+  if (NULL == dll || n != dll->objs_count) {
+    return false;
+  }
+  for (dll_obj_t * iobj = dll->head; iobj; iobj = iobj->next, ++i) {
+    if (size != iobj->size ||
+        (size && (unsigned char)i != ((unsigned char *)iobj->data)[size - 1])) {
+      return false;
+    }
+  }
+  return n == i;
+}
+
+/**
+ * \b Creates a list of \p n payloads of \p size bytes, each filled with the byte of its
+ * index.
+ */
+static dll_t * list_of_bytes(size_t n, size_t size) {
+  dll_t * dll = dll_new();
+
+  for (size_t i = 0; n > i; ++i) {
+    void * data = size ? memset(malloc(size), (int)i, size) : NULL;
+
+    dll_emplace_back(dll, data, size, LIBDLL_DESTRUCTOR_DEFAULT);
+  }
+  return dll;
+}
+
+static ssize_t count_calls(void * restrict data, void * restrict any, size_t index) {
+  (void)data;
+  (void)index;
+  ++*(size_t *)any;
+  return 0;
+}
+
+int main(void) {
+  int     fds[2];
+  dll_t * small = list_of_bytes(100, 24);
+  dll_t * empty = list_of_bytes(3, 0);
+  dll_t * big   = list_of_bytes(2, LIBDLL_IO_CHUNK + 3);
+
+  // both lists wait in the pipe before the first one is read
+  TEST_CHECK(0 == pipe(fds));
+  TEST_CHECK(dll_serialize_fd(small, fds[1]));
+  TEST_CHECK(dll_serialize_fd(empty, fds[1]));
+  close(fds[1]);
+
+  dll_t * first  = dll_deserialize_fd(fds[0]);
+  dll_t * second = dll_deserialize_fd(fds[0]);
+
+  TEST_CHECK(list_of_bytes_is(first, 100, 24));
+  TEST_CHECK(list_of_bytes_is(second, 3, 0));
+  TEST_CHECK(NULL == dll_deserialize_fd(fds[0]));
+  close(fds[0]);
+  dll_free(&first);
+  dll_free(&second);
+
+  // payloads bigger than a chunk are read straight into their memory
+  FILE * file = tmpfile();
+  int    fd   = fileno(file);
+
+  TEST_CHECK(dll_serialize_fd(big, fd));
+  TEST_CHECK(dll_serialize_fd(small, fd));
+  TEST_CHECK(0 == lseek(fd, 0, SEEK_SET));
+  first  = dll_deserialize_fd(fd);
+  second = dll_deserialize_fd(fd);
+  TEST_CHECK(list_of_bytes_is(first, 2, LIBDLL_IO_CHUNK + 3));
+  TEST_CHECK(list_of_bytes_is(second, 100, 24));
+  fclose(file);
+  dll_free(&first);
+  dll_free(&second);
+
+  file = tmpfile();
+  fd   = fileno(file);
+  TEST_CHECK(dll_map_write_fd(small, fd));
+
+  dll_map_t * map   = dll_map_open_fd(fd);
+  size_t      calls = 0;
+
+  TEST_CHECK(100 == dll_map_size(map));
+  TEST_CHECK(dll_map_foreach(map, count_calls, &calls) && 100 == calls);
+  first = dll_map_to_list(map);
+  TEST_CHECK(list_of_bytes_is(first, 100, 24));
+  TEST_CHECK(dll_map_close(&map));
+
+  // the head of a corrupted file links to itself
+  dll_map_header_t header;
+
+  TEST_CHECK(sizeof(header) == pread(fd, &header, sizeof(header), 0));
+  TEST_CHECK(sizeof(header.head) ==
+             pwrite(fd, &header.head, sizeof(header.head), (off_t)header.head));
+  map   = dll_map_open_fd(fd);
+  calls = 0;
+  TEST_CHECK(dll_map_foreach(map, count_calls, &calls) && 100 == calls);
+  second = dll_map_to_list(map);
+  TEST_CHECK(second && 100 == second->objs_count);
+  TEST_CHECK(dll_map_close(&map));
+  fclose(file);
+
+  dll_free(&first);
+  dll_free(&second);
+  dll_free(&small);
+  dll_free(&empty);
+  dll_free(&big);
+  return test_result();
+}
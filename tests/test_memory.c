@@ -0,0 +1,72 @@
+/**
+ * \file test_memory.c
+ *
+ * \brief Counters of #dll_memory_usage follow pushes, pops, splices and clears.
+ */
+
+#include "test.h"
+
+/**
+ * \b Checks the counters of #dll_memory_usage of \p dll against \p objs list-objects
+ * with \c int data allocated on their own.
+ */
+static bool memory_is(const dll_t * dll, size_t objs) {
+  dll_memory_t stats;
+
+  if (!dll_memory_usage(dll, &stats)) {
+    return false;
+  }
+  return objs == stats.objs && objs * sizeof(dll_obj_t) == stats.obj_bytes &&
+         objs * sizeof(int) == stats.data_bytes && 0 == stats.block_objs &&
+         0 == stats.block_used_bytes && 0 == stats.block_reserved_bytes &&
+         0 == stats.skip_bytes &&
+         (objs + 1) * LIBDLL_MALLOC_OVERHEAD == stats.alloc_overhead_bytes &&
+         sizeof(dll_t) + stats.obj_bytes + stats.data_bytes +
+                 stats.alloc_overhead_bytes ==
+             stats.total_bytes;
+}
+
+int main(void) {
+  dll_t * dll   = dll_new();
+  dll_t * other = dll_new();
+
+  TEST_CHECK(memory_is(dll, 0));
+  for (int i = 0; 10 > i; ++i) {
+    test_push_int(dll, i);
+    test_push_int(other, i);
+  }
+  TEST_CHECK(memory_is(dll, 10));
+
+  dll_obj_t * popped = dll_pop_front(dll);
+
+  TEST_CHECK(memory_is(dll, 9));
+  dll_free_obj(&popped);
+  TEST_CHECK(dll_delete(dll, dll->tail));
+  TEST_CHECK(memory_is(dll, 8));
+
+  // positions count from 1, both ends are moved
+  TEST_CHECK(dll_splice(dll, other, 2, 3, 7));
+  TEST_CHECK(memory_is(dll, 13));
+  TEST_CHECK(memory_is(other, 5));
+
+  dll_reverse(dll);
+  test_push_int(dll, 10);
+  TEST_CHECK(memory_is(dll, 14));
+
+  TEST_CHECK(dll_clear(dll));
+  TEST_CHECK(memory_is(dll, 0));
+
+  // sorted lists account their skip-list overlay, which goes away with the list-objects
+  dll_memory_t stats;
+
+  TEST_CHECK(dll_set_sorted(other, test_cmp_int, NULL));
+  TEST_CHECK(dll_lower_bound(other, &(int){3}));
+  TEST_CHECK(dll_memory_usage(other, &stats) && 0 < stats.skip_bytes);
+  TEST_CHECK(6 * LIBDLL_MALLOC_OVERHEAD < stats.alloc_overhead_bytes);
+  TEST_CHECK(dll_clear(other));
+  TEST_CHECK(memory_is(other, 0));
+
+  dll_free(&dll);
+  dll_free(&other);
+  return test_result();
+}
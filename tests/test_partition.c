@@ -0,0 +1,57 @@
+/**
+ * \file test_partition.c
+ *
+ * \brief #dll_partition and #dll_remove_if_into move list-objects between lists by
+ * relinking them, keep their relative order, and leave snapshots of the lists intact.
+ */
+
+#include "test.h"
+
+static ssize_t is_even(void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return *(int *)data % 2;
+}
+
+int main(void) {
+  static const int values[] = {0, 1, 2, 3, 4, 5, 6};
+  dll_t *          src      = test_list_of(values, 7);
+  dll_t *          evens    = dll_new();
+  dll_t *          odds     = dll_new();
+  dll_obj_t *      three    = src->head->next->next->next;
+
+  test_push_int(evens, -2);
+  dll_snapshot_t * snap = dll_snapshot(evens);
+
+  TEST_CHECK(4 == dll_partition(src, is_even, NULL, evens, odds));
+  TEST_CHECK(test_list_is(src, NULL, 0));
+  TEST_CHECK(test_list_is(evens, (const int[]){-2, 0, 2, 4, 6}, 5));
+  TEST_CHECK(test_list_is(odds, (const int[]){1, 3, 5}, 3));
+  // relinked, not copied
+  TEST_CHECK(three == odds->head->next);
+
+  dll_snapshot_iterator_t it = dll_snapshot_iterator(snap);
+
+  TEST_CHECK(1 == dll_snapshot_size(snap));
+  TEST_CHECK(-2 == *(int *)dll_snapshot_iterator_get_data(&it));
+  TEST_CHECK(dll_snapshot_free(&snap));
+
+  // matching list-objects stay in place without a list for them
+  dll_t * mixed = test_list_of((const int[]){7, 8, 9}, 3);
+
+  TEST_CHECK(1 == dll_partition(mixed, is_even, NULL, NULL, odds));
+  TEST_CHECK(test_list_is(mixed, (const int[]){8}, 1));
+  TEST_CHECK(test_list_is(odds, (const int[]){1, 3, 5, 7, 9}, 5));
+
+  TEST_CHECK(5 == dll_remove_if_into(evens, is_even, NULL, mixed));
+  TEST_CHECK(test_list_is(mixed, (const int[]){8, -2, 0, 2, 4, 6}, 6));
+  TEST_CHECK(test_list_is(evens, NULL, 0));
+  TEST_CHECK(0 == dll_remove_if_into(odds, is_even, NULL, mixed));
+  TEST_CHECK(test_list_is(odds, (const int[]){1, 3, 5, 7, 9}, 5));
+
+  dll_free(&mixed);
+  dll_free(&src);
+  dll_free(&evens);
+  dll_free(&odds);
+  return test_result();
+}
@@ -0,0 +1,111 @@
+/**
+ * \file test_pipe.c
+ *
+ * \brief Pipelines of libdllpipe.h run their stages in order for one list-object at a
+ * time, stop walking the list as soon as a take stage is done, and hand over indexes in
+ * the list or the ones of an enumerate stage.
+ */
+
+#include "test.h"
+
+#include <stdint.h>
+
+#include "../libdllpipe.h"
+
+static ssize_t is_even(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  if (any) {
+    ++*(size_t *)any;
+  }
+  return *(int *)data % 2;
+}
+
+static void * square(void * restrict data, void * restrict any, size_t index) {
+  (void)index;
+  return &((int *)any)[*(int *)data];
+}
+
+static ssize_t stop_at_10(void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return 10 <= *(int *)data;
+}
+
+static void * sum(void * acc, void * restrict data, void * restrict any, size_t index) {
+  (void)any;
+  (void)index;
+  return (void *)((uintptr_t)acc + (uintptr_t)*(int *)data);
+}
+
+int main(void) {
+  int     squares[20];
+  dll_t * dll = dll_new();
+
+  for (int i = 0; 20 > i; ++i) {
+    squares[i] = i * i;
+    test_push_int(dll, i);
+  }
+
+  // squares of evens after the first one, three of them, numbered from zero
+  dll_iterator_t it       = dll_iterator(dll);
+  dll_pipe_t     pipe     = dll_pipe(&it);
+  size_t         filtered = 0;
+  void *         data     = NULL;
+  size_t         index    = 0;
+
+  TEST_CHECK(dll_pipe_filter(&pipe, is_even, &filtered));
+  TEST_CHECK(dll_pipe_map(&pipe, square, squares));
+  TEST_CHECK(dll_pipe_skip(&pipe, 1));
+  TEST_CHECK(dll_pipe_enumerate(&pipe));
+  TEST_CHECK(dll_pipe_take(&pipe, 3));
+
+  static const int expected[] = {4, 16, 36};
+
+  for (size_t i = 0; 3 > i; ++i) {
+    TEST_CHECK(dll_pipe_next(&pipe, &data, &index));
+    TEST_CHECK(expected[i] == *(int *)data && i == index);
+  }
+  TEST_CHECK(!dll_pipe_next(&pipe, &data, &index));
+  // the list isn't walked past 6, the last even taken
+  TEST_CHECK(7 == filtered);
+
+  // without an enumerate stage indexes are the ones in the list, from the iterator on
+  TEST_CHECK(dll_next(&it) && dll_next(&it) && dll_next(&it));
+  pipe = dll_pipe(&it);
+  TEST_CHECK(dll_pipe_filter(&pipe, is_even, NULL));
+  TEST_CHECK(dll_pipe_next(&pipe, &data, &index));
+  TEST_CHECK(4 == *(int *)data && 4 == index);
+
+  dll_t * out = dll_new();
+
+  TEST_CHECK(7 == dll_pipe_collect(&pipe, out));
+  TEST_CHECK(test_list_is(out, (const int[]){6, 8, 10, 12, 14, 16, 18}, 7));
+  TEST_CHECK(sizeof(int) == out->head->size);
+  TEST_CHECK(LIBDLL_DESTRUCTOR_NULL == out->head->destructor);
+  dll_free(&out);
+
+  it   = dll_iterator(dll);
+  pipe = dll_pipe(&it);
+  TEST_CHECK(dll_pipe_filter(&pipe, is_even, NULL));
+  TEST_CHECK((void *)(uintptr_t)90 == dll_pipe_reduce(&pipe, sum, NULL, NULL));
+
+  // foreach stops after the callback-function returns a non-zero value
+  pipe = dll_pipe(&it);
+  TEST_CHECK(11 == dll_pipe_foreach(&pipe, stop_at_10, NULL));
+
+  // nothing is taken, so nothing is walked
+  pipe     = dll_pipe(&it);
+  filtered = 0;
+  TEST_CHECK(dll_pipe_filter(&pipe, is_even, &filtered));
+  TEST_CHECK(dll_pipe_take(&pipe, 0));
+  TEST_CHECK(!dll_pipe_next(&pipe, &data, NULL) && 0 == filtered);
+
+  pipe = dll_pipe(&it);
+  for (size_t i = 0; LIBDLL_PIPE_STAGES > i; ++i) {
+    TEST_CHECK(dll_pipe_skip(&pipe, 0));
+  }
+  TEST_CHECK(NULL == dll_pipe_skip(&pipe, 0));
+
+  dll_free(&dll);
+  return test_result();
+}
@@ -0,0 +1,139 @@
+/**
+ * \file test_reclaim.c
+ *
+ * \brief Deferred destruction through #dll_set_reclaimer within the #dll_reclaim_step
+ * budget, and relocation of list-objects by #dll_compact_step with its callback.
+ */
+
+#include "test.h"
+
+#define OBJS_COUNT 1000
+
+static size_t destroyed;
+
+static void count_destroyed(void * data) {
+  ++destroyed;
+  free(data);
+}
+
+static void test_reclaimer(void) {
+  dll_t *           dll       = dll_new();
+  dll_reclaimer_t * reclaimer = dll_reclaimer_new();
+
+  TEST_CHECK(dll_set_reclaimer(dll, reclaimer));
+  for (int i = 0; 100 > i; ++i) {
+    int * data = (int *)malloc(sizeof(*data));
+
+    *data = i;
+    dll_emplace_back(dll, data, sizeof(*data), count_destroyed);
+  }
+
+  TEST_CHECK(dll_delete(dll, dll->head));
+  TEST_CHECK(dll_clear(dll));
+  TEST_CHECK(0 == dll->objs_count && NULL == dll->head && NULL == dll->tail);
+  TEST_CHECK(0 == destroyed);
+
+  TEST_CHECK(30 == dll_reclaim_step(reclaimer, 30));
+  TEST_CHECK(30 == destroyed);
+  TEST_CHECK(30 == dll_reclaim_step(reclaimer, 30));
+  TEST_CHECK(60 == destroyed);
+  TEST_CHECK(40 == dll_reclaim_step(reclaimer, 0));
+  TEST_CHECK(100 == destroyed);
+  TEST_CHECK(0 == dll_reclaim_step(reclaimer, 0));
+
+  // the list is still usable, and frees through the reclaimer
+  test_push_int(dll, 1);
+  TEST_CHECK(dll_free(&dll));
+  TEST_CHECK(1 == dll_reclaim_step(reclaimer, 0));
+  TEST_CHECK(dll_reclaimer_free(&reclaimer));
+}
+
+typedef struct {
+  dll_obj_t * objs[OBJS_COUNT];
+  size_t      relocated;
+} tracked_t;
+
+static void track(dll_obj_t * old_obj, dll_obj_t * new_obj, void * restrict any) {
+  tracked_t * tracked = (tracked_t *)any;
+
+  for (size_t i = 0; OBJS_COUNT > i; ++i) {
+    if (old_obj == tracked->objs[i]) {
+      tracked->objs[i] = new_obj;
+      ++tracked->relocated;
+      return;
+    }
+  }
+}
+
+static void test_compact(void) {
+  dll_t *     dll      = dll_new();
+  tracked_t * tracked  = (tracked_t *)calloc(1, sizeof(*tracked));
+  void *      gaps[OBJS_COUNT];
+  int         values[OBJS_COUNT];
+
+  for (int i = 0; OBJS_COUNT > i; ++i) {
+    tracked->objs[i] = test_push_int(dll, i);
+    values[i]        = i;
+    gaps[i]          = malloc(64);
+  }
+
+  // a budgeted pass relocates up to the budget per step, in the order of the list
+  TEST_CHECK(!dll_compact_step(dll, 100, track, tracked));
+  TEST_CHECK(100 == tracked->relocated);
+  while (!dll_compact_step(dll, 100, track, tracked)) {
+  }
+  TEST_CHECK(OBJS_COUNT == tracked->relocated);
+  TEST_CHECK(test_list_is(dll, values, OBJS_COUNT));
+
+  dll_iterator_t it = dll_iterator(dll);
+
+  for (size_t i = 0; OBJS_COUNT > i; ++i, dll_next(&it)) {
+    TEST_CHECK(tracked->objs[i] == dll_iterator_get_obj(&it));
+  }
+
+  dll_memory_t stats;
+
+  TEST_CHECK(dll_memory_usage(dll, &stats));
+  TEST_CHECK(OBJS_COUNT == stats.block_objs);
+  TEST_CHECK(OBJS_COUNT * sizeof(dll_obj_t) == stats.block_used_bytes);
+  TEST_CHECK(stats.block_used_bytes <= stats.block_reserved_bytes);
+  TEST_CHECK(0 == stats.block_reserved_bytes % LIBDLL_BLOCK_SIZE);
+
+  // list-objects pushed after the pass live on their own until the next one
+  test_push_int(dll, OBJS_COUNT);
+  TEST_CHECK(dll_compact(dll, NULL, NULL));
+  TEST_CHECK(dll_memory_usage(dll, &stats));
+  TEST_CHECK(OBJS_COUNT + 1 == stats.block_objs);
+  TEST_CHECK((OBJS_COUNT + __DLLI_BLOCK_OBJS) / __DLLI_BLOCK_OBJS * LIBDLL_BLOCK_SIZE ==
+             stats.block_reserved_bytes);
+
+  // list-objects moved to another list still reserve their blocks, for both lists
+  dll_t * other = dll_new();
+
+  for (size_t i = 0; 10 > i; ++i) {
+    TEST_CHECK(dll_push_back(other, dll_pop_front(dll)));
+  }
+  TEST_CHECK(dll_memory_usage(other, &stats));
+  TEST_CHECK(10 == stats.block_objs);
+  TEST_CHECK(10 * LIBDLL_BLOCK_SIZE == stats.block_reserved_bytes);
+  TEST_CHECK(dll_memory_usage(dll, &stats));
+  TEST_CHECK((OBJS_COUNT + __DLLI_BLOCK_OBJS) / __DLLI_BLOCK_OBJS * LIBDLL_BLOCK_SIZE ==
+             stats.block_reserved_bytes);
+  for (size_t i = 0; 10 > i; ++i) {
+    TEST_CHECK(dll_push_front(dll, dll_pop_back(other)));
+  }
+  TEST_CHECK(dll_memory_usage(other, &stats) && 0 == stats.block_reserved_bytes);
+  dll_free(&other);
+
+  for (size_t i = 0; OBJS_COUNT > i; ++i) {
+    free(gaps[i]);
+  }
+  free(tracked);
+  dll_free(&dll);
+}
+
+int main(void) {
+  test_reclaimer();
+  test_compact();
+  return test_result();
+}
@@ -0,0 +1,57 @@
+/**
+ * \file test_reverse.c
+ *
+ * \brief #dll_reverse flips a list in O(1), and pushes, pops, inserts and deletes on the
+ * reversed list follow its new order.
+ */
+
+#include "test.h"
+
+int main(void) {
+  static const int values[] = {0, 1, 2, 3, 4};
+  dll_t *          dll      = test_list_of(values, 5);
+
+  TEST_CHECK(dll_reverse(dll));
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 3, 2, 1, 0}, 5));
+
+  test_push_int(dll, -1);
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 3, 2, 1, 0, -1}, 6));
+
+  int * front = (int *)malloc(sizeof(*front));
+
+  *front = 5;
+  dll_emplace_front(dll, front, sizeof(*front), LIBDLL_DESTRUCTOR_DEFAULT);
+  TEST_CHECK(test_list_is(dll, (const int[]){5, 4, 3, 2, 1, 0, -1}, 7));
+
+  int * middle = (int *)malloc(sizeof(*middle));
+
+  *middle = 9;
+  dll_emplace(dll, middle, sizeof(*middle), LIBDLL_DESTRUCTOR_DEFAULT, 2);
+  TEST_CHECK(test_list_is(dll, (const int[]){5, 4, 9, 3, 2, 1, 0, -1}, 8));
+
+  dll_obj_t * popped = dll_pop_front(dll);
+
+  TEST_CHECK(popped && 5 == *(int *)popped->data);
+  dll_free_obj(&popped);
+  popped = dll_pop_back(dll);
+  TEST_CHECK(popped && -1 == *(int *)popped->data);
+  dll_free_obj(&popped);
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 9, 3, 2, 1, 0}, 6));
+
+  dll_iterator_t it = dll_iterator(dll);
+
+  dll_next(&it);
+  TEST_CHECK(dll_delete(dll, dll_iterator_get_obj(&it)));
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 3, 2, 1, 0}, 5));
+
+  TEST_CHECK(dll_reverse(dll));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 3, 4}, 5));
+
+  TEST_CHECK(dll_reverse_relink(dll));
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 3, 2, 1, 0}, 5));
+  test_push_int(dll, 7);
+  TEST_CHECK(test_list_is(dll, (const int[]){4, 3, 2, 1, 0, 7}, 6));
+
+  dll_free(&dll);
+  return test_result();
+}
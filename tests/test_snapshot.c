@@ -0,0 +1,80 @@
+/**
+ * \file test_snapshot.c
+ *
+ * \brief A #dll_snapshot keeps seeing the list as it was, whatever the list goes through
+ * afterwards, and keeps data of deleted list-objects alive.
+ */
+
+#include "test.h"
+
+static size_t destroyed;
+
+static void count_destroyed(void * data) {
+  ++destroyed;
+  free(data);
+}
+
+/**
+ * \b Checks that \p snap holds exactly \p n \p values in this order.
+ */
+static bool snapshot_is(const dll_snapshot_t * snap, const int * values, size_t n) {
+  dll_snapshot_iterator_t it = dll_snapshot_iterator(snap);
+  size_t                  i  = 0;
+
+  if (n != dll_snapshot_size(snap)) {
+    return false;
+  }
+  for (int * data; n > i && (data = (int *)dll_snapshot_iterator_get_data(&it)); ++i) {
+    if (values[i] != *data) {
+      return false;
+    }
+    dll_snapshot_next(&it);
+  }
+  return n == i && NULL == dll_snapshot_iterator_get_data(&it);
+}
+
+int main(void) {
+  static const int values[] = {0, 1, 2, 3, 4};
+  dll_t *          dll      = dll_new();
+
+  for (int i = 0; 5 > i; ++i) {
+    int * data = (int *)malloc(sizeof(*data));
+
+    *data = i;
+    dll_emplace_back(dll, data, sizeof(*data), count_destroyed);
+  }
+
+  // snapshots of an unmodified list are the same one
+  dll_snapshot_t * snap  = dll_snapshot(dll);
+  dll_snapshot_t * again = dll_snapshot(dll);
+
+  TEST_CHECK(snap && snap == again);
+  TEST_CHECK(dll_snapshot_free(&again));
+  TEST_CHECK(snapshot_is(snap, values, 5));
+
+  dll_reverse(dll);
+  test_push_int(dll, 9);
+  TEST_CHECK(dll_delete(dll, dll->head));
+  TEST_CHECK(dll_sort(dll, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 3, 9}, 5));
+  TEST_CHECK(0 == destroyed);
+  TEST_CHECK(snapshot_is(snap, values, 5));
+
+  // a snapshot after the writes sees them, the older one still doesn't
+  dll_snapshot_t * later = dll_snapshot(dll);
+
+  TEST_CHECK(later && later != snap);
+  TEST_CHECK(dll_clear(dll));
+  TEST_CHECK(0 == destroyed);
+  TEST_CHECK(snapshot_is(later, (const int[]){0, 1, 2, 3, 9}, 5));
+  TEST_CHECK(snapshot_is(snap, values, 5));
+
+  TEST_CHECK(dll_snapshot_free(&later));
+  TEST_CHECK(NULL == later);
+  TEST_CHECK(snapshot_is(snap, values, 5));
+  TEST_CHECK(dll_snapshot_free(&snap));
+  TEST_CHECK(5 == destroyed);
+
+  dll_free(&dll);
+  return test_result();
+}
@@ -0,0 +1,121 @@
+/**
+ * \file test_sort.c
+ *
+ * \brief Results of #dll_sort , #dll_partial_sort and #dll_nth_element , and insertion
+ * and search in the sorted mode of #dll_set_sorted .
+ */
+
+#include "test.h"
+
+static const int values[] = {7, 3, 9, 3, 0, 8, 1, 6, 2, 5, 4};
+#define VALUES_COUNT (sizeof(values) / sizeof(*values))
+
+static ssize_t count_calls(void * data, void * any, size_t index) {
+  (void)data;
+  (void)index;
+  ++*(size_t *)any;
+  return 0;
+}
+
+static void test_sort(void) {
+  dll_t * dll = test_list_of(values, VALUES_COUNT);
+
+  TEST_CHECK(dll_sort(dll, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9}, 11));
+  dll_free(&dll);
+}
+
+static void test_partial_sort(void) {
+  dll_t * dll = test_list_of(values, VALUES_COUNT);
+
+  // the 3 smallest in order, then the rest in their original order
+  TEST_CHECK(dll_partial_sort(dll, 3, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 7, 3, 9, 3, 8, 6, 5, 4}, 11));
+
+  TEST_CHECK(dll_partial_sort(dll, 100, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9}, 11));
+  dll_free(&dll);
+}
+
+static void test_nth_element(void) {
+  for (size_t n = 0; VALUES_COUNT > n; ++n) {
+    dll_t *     dll      = test_list_of(values, VALUES_COUNT);
+    dll_obj_t * selected = dll_nth_element(dll, n, test_cmp_int, NULL);
+    static const int sorted[] = {0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9};
+
+    TEST_CHECK(selected && sorted[n] == *(int *)selected->data);
+    TEST_CHECK(VALUES_COUNT == dll->objs_count);
+
+    dll_iterator_t it = dll_iterator(dll);
+
+    for (size_t i = 0; dll_iterator_get_obj(&it); ++i, dll_next(&it)) {
+      const int value = *(int *)dll_iterator_get_data(&it);
+
+      TEST_CHECK(i < n ? value <= sorted[n] : value >= sorted[n]);
+      TEST_CHECK(i != n || dll_iterator_get_obj(&it) == selected);
+    }
+    dll_free(&dll);
+  }
+
+  dll_t * dll = test_list_of(values, VALUES_COUNT);
+
+  TEST_CHECK(NULL == dll_nth_element(dll, VALUES_COUNT, test_cmp_int, NULL));
+  dll_free(&dll);
+}
+
+static void test_sorted_mode(void) {
+  dll_t * dll = test_list_of(values, VALUES_COUNT);
+
+  TEST_CHECK(dll_set_sorted(dll, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9}, 11));
+
+  for (int i = 0; 3 > i; ++i) {
+    int * data = (int *)malloc(sizeof(*data));
+
+    *data = 3 * i + 1;
+    TEST_CHECK(dll_emplace_sorted(dll, data, sizeof(*data), LIBDLL_DESTRUCTOR_DEFAULT));
+  }
+  TEST_CHECK(test_list_is(
+      dll, (const int[]){0, 1, 1, 2, 3, 3, 4, 4, 5, 6, 7, 7, 8, 9}, 14));
+
+  int         key   = 3;
+  dll_obj_t * lower = dll_lower_bound(dll, &key);
+  dll_obj_t * upper = dll_upper_bound(dll, &key);
+
+  TEST_CHECK(lower && 3 == *(int *)lower->data);
+  TEST_CHECK(upper && 4 == *(int *)upper->data);
+  TEST_CHECK(lower != upper && upper != lower->next);
+
+  key = 10;
+  TEST_CHECK(NULL == dll_lower_bound(dll, &key));
+  key = -1;
+  TEST_CHECK(dll->head == dll_lower_bound(dll, &key));
+
+  int    from  = 3;
+  int    to    = 7;
+  size_t calls = 0;
+
+  TEST_CHECK(6 == dll_foreach_range(dll, &from, &to, count_calls, &calls));
+  TEST_CHECK(6 == calls);
+
+  // deleting keeps the overlay in sync
+  key = 4;
+  TEST_CHECK(dll_delete(dll, dll_lower_bound(dll, &key)));
+  TEST_CHECK(dll_delete(dll, dll_lower_bound(dll, &key)));
+  TEST_CHECK(5 == *(int *)dll_lower_bound(dll, &key)->data);
+  TEST_CHECK(test_list_is(dll, (const int[]){0, 1, 1, 2, 3, 3, 5, 6, 7, 7, 8, 9}, 12));
+
+  // a push out of order drops the overlay, sorting again brings the mode back
+  test_push_int(dll, 4);
+  TEST_CHECK(dll_set_sorted(dll, test_cmp_int, NULL));
+  TEST_CHECK(4 == *(int *)dll_lower_bound(dll, &key)->data);
+  dll_free(&dll);
+}
+
+int main(void) {
+  test_sort();
+  test_partial_sort();
+  test_nth_element();
+  test_sorted_mode();
+  return test_result();
+}
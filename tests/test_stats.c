@@ -0,0 +1,53 @@
+/**
+ * \file test_stats.c
+ *
+ * \brief With #LIBDLL_STATS , \c allocs counts the list-objects allocated by emplace
+ * functions once each, and never list-objects which were only linked.
+ */
+
+#include "test.h"
+
+static int * new_int(int value) {
+  int * data = (int *)malloc(sizeof(*data));
+
+  *data = value;
+  return data;
+}
+
+int main(void) {
+  dll_t * dll = dll_new();
+
+  TEST_CHECK(dll_emplace_back(dll, new_int(2), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT));
+  TEST_CHECK(dll_emplace_front(dll, new_int(0), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT));
+  TEST_CHECK(2 == dll->stats.allocs);
+
+  // emplace at the front goes through dll_insert as well
+  TEST_CHECK(dll_emplace(dll, new_int(-1), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT, 0));
+  TEST_CHECK(dll_emplace(dll, new_int(1), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT, 2));
+  TEST_CHECK(4 == dll->stats.allocs);
+  TEST_CHECK(test_list_is(dll, (const int[]){-1, 0, 1, 2}, 4));
+
+  // a failed emplace allocates nothing that stays
+  int * lost = new_int(9);
+
+  TEST_CHECK(NULL == dll_emplace(dll, lost, sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT, 9));
+  TEST_CHECK(4 == dll->stats.allocs);
+  free(lost);
+
+  // list-objects of the caller are linked, not copied
+  dll_obj_t * front = dll_new_obj(new_int(-2), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT);
+  dll_obj_t * back  = dll_new_obj(new_int(3), sizeof(int), LIBDLL_DESTRUCTOR_DEFAULT);
+
+  TEST_CHECK(front == dll_insert(dll, front, 0));
+  TEST_CHECK(back == dll_insert(dll, back, 5));
+  TEST_CHECK(front == dll->head && back == dll->tail);
+  TEST_CHECK(4 == dll->stats.allocs);
+  TEST_CHECK(test_list_is(dll, (const int[]){-2, -1, 0, 1, 2, 3}, 6));
+
+  TEST_CHECK(dll_clear(dll));
+  TEST_CHECK(6 == dll->stats.frees);
+  TEST_CHECK(dll_stats_reset(dll) && 0 == dll->stats.allocs);
+
+  dll_free(&dll);
+  return test_result();
+}
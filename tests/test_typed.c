@@ -0,0 +1,72 @@
+/**
+ * \file test_typed.c
+ *
+ * \brief Functions generated by #DLL_DEFINE_TYPED give the same lists as the generic
+ * functions with a callback-function, and mix with them on the same #dll_t lists.
+ */
+
+#include "test.h"
+
+DLL_DEFINE_TYPED(dll_int, int, (*a > *b) - (*a < *b))
+
+/**
+ * \b Creates a list of copies of \p n \p values , emplacing them in front from the last
+ * one.
+ */
+static dll_t * typed_list_of(const int * values, size_t n) {
+  dll_t * dll = dll_new();
+
+  for (size_t i = n; i--;) {
+    int * data = (int *)malloc(sizeof(*data));
+
+    *data = values[i];
+    dll_int_emplace_front(dll, data, LIBDLL_DESTRUCTOR_DEFAULT);
+  }
+  return dll;
+}
+
+int main(void) {
+  static const int values[] = {5, 3, 9, 3, 0, 7, 5, 5, 1, 8, 2, 9};
+  dll_t *          typed    = typed_list_of(values, 12);
+  dll_t *          generic  = test_list_of(values, 12);
+
+  TEST_CHECK(test_list_is(typed, values, 12));
+  TEST_CHECK(typed->head->size == sizeof(int));
+  TEST_CHECK(dll_int_is_equal(typed, generic));
+
+  TEST_CHECK(dll_int_sort(typed));
+  TEST_CHECK(dll_sort(generic, test_cmp_int, NULL));
+  TEST_CHECK(test_list_is(typed, (const int[]){0, 1, 2, 3, 3, 5, 5, 5, 7, 8, 9, 9}, 12));
+  TEST_CHECK(dll_int_is_equal(typed, generic));
+
+  // sorting a reversed list relinks it in the sorted order
+  TEST_CHECK(dll_reverse(typed));
+  TEST_CHECK(dll_int_sort(typed));
+  TEST_CHECK(dll_is_equal(typed, generic, test_cmp_int, NULL));
+
+  int   key   = 7;
+  int * found = dll_int_find(typed, &key);
+
+  TEST_CHECK(found && 7 == *found);
+  key = 4;
+  TEST_CHECK(NULL == dll_int_find(typed, &key));
+
+  key = 5;
+  TEST_CHECK(3 == dll_int_remove(typed, &key));
+  TEST_CHECK(0 == dll_int_remove(typed, &key));
+  TEST_CHECK(2 == dll_int_unique(typed));
+  TEST_CHECK(test_list_is(typed, (const int[]){0, 1, 2, 3, 7, 8, 9}, 7));
+
+  TEST_CHECK(4 == dll_unique(generic, test_cmp_int, NULL));
+  TEST_CHECK(!dll_int_is_equal(typed, generic));
+
+  int * back = (int *)malloc(sizeof(*back));
+
+  *back = 10;
+  TEST_CHECK(dll_int_emplace_back(typed, back, LIBDLL_DESTRUCTOR_DEFAULT));
+  TEST_CHECK(test_list_is(typed, (const int[]){0, 1, 2, 3, 7, 8, 9, 10}, 8));
+
+  dll_free(&typed);
+  dll_free(&generic);
+  return test_result();
+}